@@ -4,12 +4,37 @@
 echo "🏗️  Building City Designer..."
 echo ""
 
+# COUNT_ALLOCATIONS=1 replaces the global operator new/delete to report heap
+# bytes per generation stage in the profile (J key)
+EXTRA_FLAGS=""
+if [ "$COUNT_ALLOCATIONS" = "1" ]; then
+    echo "Counting heap allocations for generation profiles"
+    EXTRA_FLAGS="-DCOUNT_ALLOCATIONS"
+fi
+
+# CHECK_ROAD_COVERAGE=1 checks the joined road mesh against the plain road
+# quads: the hard joins once at startup, then every network as it is shown
+if [ "$CHECK_ROAD_COVERAGE" = "1" ]; then
+    echo "Checking road mesh coverage"
+    EXTRA_FLAGS="$EXTRA_FLAGS -DCHECK_ROAD_COVERAGE"
+fi
+
 clang++ src/main.cpp \
         src/glad.c \
         src/core/application.cpp \
         src/core/city_config.cpp \
         src/generation/city_generator.cpp \
         src/generation/road_generator.cpp \
+        src/generation/road_graph.cpp \
+        src/generation/block_partition.cpp \
+        src/generation/generation_pipeline.cpp \
+        src/generation/generation_worker.cpp \
+        src/generation/city_stream.cpp \
+        src/generation/generation_profiler.cpp \
+        src/generation/allocation_counter.cpp \
+        src/generation/city_cache.cpp \
+        src/generation/spatial_grid.cpp \
+        src/generation/occupancy_grid.cpp \
         src/rendering/texture_manager.cpp \
         src/rendering/3d/camera.cpp \
         src/rendering/city_renderer.cpp \
@@ -19,6 +44,8 @@ clang++ src/main.cpp \
         src/rendering/mesh/park_mesh.cpp \
         src/rendering/mesh/mesh_utils.cpp \
         src/utils/algorithms.cpp \
+        src/utils/geometry.cpp \
+        src/utils/delaunay.cpp \
         src/utils/input_handler.cpp \
         -o CityDesigner \
         -Iinclude \
@@ -27,7 +54,8 @@ clang++ src/main.cpp \
         -L/opt/homebrew/lib \
         -lglfw \
         -framework OpenGL \
-        -std=c++17
+        -std=c++17 \
+        $EXTRA_FLAGS
 
 if [ $? -eq 0 ]; then
     echo ""
@@ -78,6 +78,12 @@ public:
      */
     void setupCallbacks(Camera* camera);
     
+    /**
+     * @brief Change the window title
+     * @param newTitle Text for the title bar
+     */
+    void setTitle(const std::string& newTitle);
+    
     /**
      * @brief Get window width
      * @return int Width in pixels
@@ -90,6 +96,15 @@ public:
      */
     int getHeight() const { return height; }
     
+    /**
+     * @brief Get the current framebuffer size
+     * @param fbWidth Output: width in pixels (0 while minimized)
+     * @param fbHeight Output: height in pixels (0 while minimized)
+     * 
+     * Differs from the window size after a resize and on high-DPI screens.
+     */
+    void getFramebufferSize(int& fbWidth, int& fbHeight) const;
+    
 private:
     GLFWwindow* window;
     int width;
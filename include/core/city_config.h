@@ -12,7 +12,9 @@
 #ifndef CITY_CONFIG_H
 #define CITY_CONFIG_H
 
+#include <algorithm>
 #include <string>
+#include <cstdint>
 
 /**
  * @enum RoadPattern
@@ -21,7 +23,8 @@
 enum class RoadPattern {
     GRID,       ///< Traditional grid layout (Manhattan-style)
     RADIAL,     ///< Radial pattern with spokes from center
-    RANDOM      ///< Random organic road network
+    RANDOM,     ///< Random organic road network
+    ORGANIC     ///< Planar, connected network thinned from a Delaunay triangulation
 };
 
 /**
@@ -46,6 +49,66 @@ enum class TextureTheme {
     FUTURISTIC      ///< Futuristic high-tech appearance
 };
 
+/**
+ * @enum CollisionBackend
+ * @brief Collision test used when placing buildings
+ */
+enum class CollisionBackend {
+    GEOMETRIC,      ///< Exact shape tests against nearby elements (spatial grid)
+    RASTER          ///< Bit-packed occupancy bitmap, fastest for dense cities
+};
+
+/**
+ * @enum PlacementMode
+ * @brief Sampling strategy used to choose building positions
+ */
+enum class PlacementMode {
+    RANDOM,         ///< Blind rejection sampling of uniform random positions
+    POISSON_DISK,   ///< Bridson Poisson-disk sampling with an active list
+    PARALLEL_TILES, ///< Rejection sampling on worker threads, tile by tile
+    BLOCK_LOTS      ///< One building per lot, cut from the blocks between roads
+};
+
+/**
+ * @enum ScaleTier
+ * @brief Preset world sizes, from a single district to a whole metropolis
+ */
+enum class ScaleTier {
+    DISTRICT,       ///< 800x600 world units, up to 100 buildings
+    CITY,           ///< 8000x6000 world units, up to 10,000 buildings
+    METROPOLIS      ///< 100000x75000 world units, up to 1,000,000 buildings
+};
+
+/**
+ * @struct WorldExtent
+ * @brief Size of the generated world, independent of the window
+ * 
+ * Generation works in world units: one unit is one screen pixel at the
+ * default district size. Renderers map the whole extent onto the view,
+ * so a larger world shows more city rather than a cropped one. Sizes set
+ * in pixels are scaled to world units by CityConfig::worldUnit().
+ */
+struct WorldExtent {
+    float width;    ///< Extent along X in world units
+    float height;   ///< Extent along Y in world units
+    float margin;   ///< Border kept clear of roads and buildings
+    
+    WorldExtent(float w = 800.0f, float h = 600.0f, float m = 50.0f)
+        : width(w), height(h), margin(m) {}
+    
+    /// Map a world X coordinate to view space (-1 to 1)
+    float toViewX(float x) const { return x / (width / 2.0f) - 1.0f; }
+    
+    /// Map a world Y coordinate to view space (1 to -1, Y grows downward in the world)
+    float toViewY(float y) const { return 1.0f - y / (height / 2.0f); }
+    
+    /// Map a length along X to view space
+    float toViewSizeX(float size) const { return size / (width / 2.0f); }
+    
+    /// Map a length along Y to view space
+    float toViewSizeY(float size) const { return size / (height / 2.0f); }
+};
+
 /**
  * @struct CityConfig
  * @brief Comprehensive city generation configuration
@@ -55,13 +118,17 @@ enum class TextureTheme {
  * be modified at runtime through keyboard controls.
  */
 struct CityConfig {
+    // ===== World Parameters =====
+    ScaleTier scaleTier;        ///< Preset that sets the world extent and parameter caps
+    WorldExtent world;          ///< Size of the world generation runs in
+    
     // ===== Building Parameters =====
-    int numBuildings;           ///< Number of buildings to generate (1-100)
-    int layoutSize;             ///< Size of the city grid, e.g., 10 = 10x10 (5-20)
+    int numBuildings;           ///< Number of buildings to generate (1 to maxBuildings())
+    int layoutSize;             ///< Size of the city grid, e.g., 10 = 10x10 (5 to maxLayoutSize())
     
     // ===== Road Parameters =====
     RoadPattern roadPattern;    ///< Type of road network pattern
-    int roadWidth;              ///< Width of roads in pixels (2-20)
+    int roadWidth;              ///< Width of roads in district pixels (2-20)
     
     // ===== Skyline Parameters =====
     SkylineType skylineType;    ///< Building height distribution strategy
@@ -70,15 +137,22 @@ struct CityConfig {
     TextureTheme textureTheme;  ///< Building facade visual theme
     
     // ===== Park/Fountain Parameters =====
-    int parkRadius;             ///< Radius for circular parks in pixels (10-100)
+    int parkRadius;             ///< Radius for circular parks in district pixels (10-100)
     int numParks;               ///< Number of parks to generate (0-10)
-    int fountainRadius;         ///< Radius for central fountain (25 or 40)
+    int fountainRadius;         ///< Radius for central fountain in district pixels (25 or 40)
     
     // ===== Building Size Parameters =====
     bool useStandardSize;       ///< If true, all buildings use standard dimensions
     float standardWidth;        ///< Standard building width when useStandardSize=true
     float standardDepth;        ///< Standard building depth when useStandardSize=true
     
+    // ===== Placement Parameters =====
+    PlacementMode placementMode;       ///< How candidate building positions are sampled
+    CollisionBackend collisionBackend; ///< How building placement detects overlaps
+    
+    // ===== Generation Parameters =====
+    uint32_t seed;              ///< Seed for every random choice; same config + seed = same city
+    
     // ===== View Mode =====
     bool view3D;                ///< Toggle: false=2D orthographic, true=3D perspective
     
@@ -93,7 +167,8 @@ struct CityConfig {
      * - Starting in 2D view mode
      */
     CityConfig() 
-        : numBuildings(20),
+        : scaleTier(ScaleTier::DISTRICT),
+          numBuildings(20),
           layoutSize(10),
           roadPattern(RoadPattern::GRID),
           roadWidth(14),
@@ -105,12 +180,104 @@ struct CityConfig {
           useStandardSize(true),
           standardWidth(50.0f),
           standardDepth(50.0f),
+          placementMode(PlacementMode::RANDOM),
+          collisionBackend(CollisionBackend::GEOMETRIC),
+          seed(1),
           view3D(false)
     {
         // Initialize building size based on default layout
         updateStandardBuildingSize();
     }
     
+    /**
+     * @brief Switch to the world extent of the current scale tier
+     * 
+     * The extent and margin are the district's times worldUnit(). Clamps
+     * the building count and layout size to the new tier's caps and
+     * recomputes the standard building size for the new extent.
+     */
+    void applyScaleTier() {
+        float unit = worldUnit();
+        world = WorldExtent(800.0f * unit, 600.0f * unit, 50.0f * unit);
+        
+        if (numBuildings > maxBuildings()) numBuildings = maxBuildings();
+        if (layoutSize > maxLayoutSize()) layoutSize = maxLayoutSize();
+        updateStandardBuildingSize();
+    }
+    
+    /**
+     * @brief World units per district pixel in the current scale tier
+     * 
+     * Road width, park and fountain radii, the world margin and building
+     * heights are given in district pixels and multiplied by this, so a
+     * larger tier at the same layout size looks like the district seen
+     * from further away. Placement clearances stay in world units, which
+     * lets dense layouts hold the tier's building cap.
+     * 
+     * @return 1 for DISTRICT, 10 for CITY, 125 for METROPOLIS
+     */
+    float worldUnit() const {
+        switch(scaleTier) {
+            case ScaleTier::CITY: return 10.0f;
+            case ScaleTier::METROPOLIS: return 125.0f;
+            case ScaleTier::DISTRICT:
+            default: return 1.0f;
+        }
+    }
+    
+    /**
+     * @brief Road width in world units
+     * 
+     * roadWidth times worldUnit(), but never more than half a layout
+     * cell, so dense layouts in the larger tiers keep land between roads.
+     * 
+     * @return Width to give every road, at least 1
+     */
+    int worldRoadWidth() const {
+        float cellSize = (world.width - 2.0f * world.margin) / layoutSize;
+        float width = std::min(roadWidth * worldUnit(), cellSize / 2.0f);
+        return std::max(1, static_cast<int>(width));
+    }
+    
+    /**
+     * @brief Largest building count the current scale tier allows
+     * @return Maximum value for numBuildings
+     */
+    int maxBuildings() const {
+        switch(scaleTier) {
+            case ScaleTier::CITY: return 10000;
+            case ScaleTier::METROPOLIS: return 1000000;
+            case ScaleTier::DISTRICT:
+            default: return 100;
+        }
+    }
+    
+    /**
+     * @brief Largest layout size the current scale tier allows
+     * @return Maximum value for layoutSize
+     */
+    int maxLayoutSize() const {
+        switch(scaleTier) {
+            case ScaleTier::CITY: return 100;
+            case ScaleTier::METROPOLIS: return 500;
+            case ScaleTier::DISTRICT:
+            default: return 20;
+        }
+    }
+    
+    /**
+     * @brief Convert scale tier enum to human-readable string
+     * @return String representation of the scale tier
+     */
+    std::string getScaleTierString() const {
+        switch(scaleTier) {
+            case ScaleTier::DISTRICT: return "District";
+            case ScaleTier::CITY: return "City";
+            case ScaleTier::METROPOLIS: return "Metropolis";
+            default: return "Unknown";
+        }
+    }
+    
     /**
      * @brief Convert road pattern enum to human-readable string
      * @return String representation of the road pattern
@@ -120,6 +287,7 @@ struct CityConfig {
             case RoadPattern::GRID: return "Grid";
             case RoadPattern::RADIAL: return "Radial";
             case RoadPattern::RANDOM: return "Random";
+            case RoadPattern::ORGANIC: return "Organic";
             default: return "Unknown";
         }
     }
@@ -152,18 +320,42 @@ struct CityConfig {
         }
     }
     
+    /**
+     * @brief Convert placement mode enum to human-readable string
+     * @return String representation of the placement mode
+     */
+    std::string getPlacementModeString() const {
+        switch(placementMode) {
+            case PlacementMode::RANDOM: return "Random";
+            case PlacementMode::POISSON_DISK: return "Poisson-Disk";
+            case PlacementMode::PARALLEL_TILES: return "Parallel Tiles";
+            case PlacementMode::BLOCK_LOTS: return "Block Lots";
+            default: return "Unknown";
+        }
+    }
+    
+    /**
+     * @brief Convert collision backend enum to human-readable string
+     * @return String representation of the collision backend
+     */
+    std::string getCollisionBackendString() const {
+        switch(collisionBackend) {
+            case CollisionBackend::GEOMETRIC: return "Geometric";
+            case CollisionBackend::RASTER: return "Raster";
+            default: return "Unknown";
+        }
+    }
+    
     /**
      * @brief Calculate optimal building size based on layout grid
-     * @param screenWidth Width of the screen/window in pixels
-     * @param margin Margin from screen edges in pixels
      * 
      * Automatically adjusts standardWidth and standardDepth to fit
-     * buildings within the grid cells, accounting for roads.
+     * buildings within the grid cells of the world, accounting for roads.
      * Buildings are sized to ~40% of cell size for proper spacing.
      */
-    void updateStandardBuildingSize(int screenWidth = 800, int margin = 50) {
+    void updateStandardBuildingSize() {
         // Calculate grid cell size
-        float cellSize = static_cast<float>(screenWidth - 2 * margin) / layoutSize;
+        float cellSize = (world.width - 2.0f * world.margin) / layoutSize;
         // Buildings should be about 40% of cell size to fit within one grid square
         // This accounts for road width and proper spacing
         standardWidth = cellSize * 0.40f;
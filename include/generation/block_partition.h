@@ -0,0 +1,73 @@
+#ifndef BLOCK_PARTITION_H
+#define BLOCK_PARTITION_H
+
+#include <vector>
+#include "generation/road_generator.h"
+
+// Axis-aligned parcel of land inside one block, clear of every obstacle
+struct Lot {
+    float minX, minY, maxX, maxY;
+    int block;      // Index of the block the lot was cut from
+
+    Lot(float x0, float y0, float x1, float y1, int b)
+        : minX(x0), minY(y0), maxX(x1), maxY(y1), block(b) {}
+};
+
+// Circular keep-out area, such as a park grown by its clearance. A lot is
+// clear of it when the lot, grown by boxGrowth on every side, stays outside
+// the circle; this matches the box-versus-circle test used for placement.
+struct KeepOutCircle {
+    float x, y;
+    float radius;
+    float boxGrowth;
+
+    KeepOutCircle(float cx, float cy, float r, float growth)
+        : x(cx), y(cy), radius(r), boxGrowth(growth) {}
+};
+
+// One bounded face of the road network inside the city bounds
+struct CityBlock {
+    std::vector<float> xs, ys;      // Boundary polygon; edge i runs from vertex i to i + 1
+    std::vector<float> clearance;   // Distance lots keep from each boundary edge. Zero
+                                    // means lots may touch the edge but not cross it.
+    float area;
+    float minX, minY, maxX, maxY;   // Bounding box, clipped to the city bounds
+};
+
+// Block Partition
+// Splits the city into blocks, the faces of the planar road graph closed
+// off by the city bounds, and each block into lots. Lots keep the required
+// distance from the roads around their block and from keep-out circles,
+// and never overlap each other, so anything placed inside a lot needs no
+// further collision tests.
+//
+// Lots come from recursive axis-aligned splits on a lot-sized lattice:
+// clear cells split straight into lots, and only cells touching a block
+// edge or keep-out circle are refined further. The work is linear in the
+// number of lots plus the length of block boundaries.
+class BlockPartition {
+private:
+    std::vector<CityBlock> blocks;
+    float boundsMinX, boundsMinY, boundsMaxX, boundsMaxY;
+
+public:
+    BlockPartition();
+
+    // Find the blocks of a road network. roadClearance holds the distance
+    // lots keep from each road; the bounds close off the outermost blocks.
+    void build(const std::vector<Road>& roads, const std::vector<float>& roadClearance,
+               int minX, int minY, int maxX, int maxY);
+
+    const std::vector<CityBlock>& getBlocks() const { return blocks; }
+
+    // Sum of block areas inside the bounds
+    float totalArea() const;
+
+    // Cut every block into lots of about lotWidth x lotDepth. Cells near
+    // obstacles are refined down to minWidth x minDepth; smaller leftovers
+    // are dropped.
+    std::vector<Lot> subdivide(float lotWidth, float lotDepth, float minWidth, float minDepth,
+                               const std::vector<KeepOutCircle>& keepOut) const;
+};
+
+#endif // BLOCK_PARTITION_H
@@ -0,0 +1,51 @@
+#ifndef CITY_CACHE_H
+#define CITY_CACHE_H
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include "core/city_config.h"
+#include "generation/city_data.h"
+
+// Generated City Cache
+// Generation is deterministic for a given configuration and seed, so a
+// finished CityData can be stored under a hash of everything that affects
+// it and handed back when the same city is requested again.
+//
+// Two levels are kept: a small in-memory table of recent cities and one
+// binary file per city in a cache directory, which survives restarts.
+class CityCache {
+private:
+    std::string directory;                              // On-disk cache location
+    size_t memoryCapacity;                              // Max cities kept in memory
+    std::unordered_map<uint64_t, CityData> memory;
+    std::deque<uint64_t> insertionOrder;                // Oldest key first, for eviction
+
+public:
+    explicit CityCache(const std::string& directory = "city_cache", size_t memoryCapacity = 16);
+
+    // Hash every configuration field that influences generation. Display-only
+    // settings (texture theme, view mode) are left out so toggling them does
+    // not miss the cache.
+    static uint64_t keyFor(const CityConfig& config);
+
+    // Look a city up in memory, then on disk. Returns false on a miss.
+    bool lookup(uint64_t key, CityData& out);
+
+    // Remember a generated city in memory and write it to disk
+    void store(uint64_t key, const CityData& city);
+
+private:
+    // Helper: Path of the cache file for a key
+    std::string pathFor(uint64_t key) const;
+
+    // Helper: Add to the in-memory table, evicting the oldest entry if full
+    void remember(uint64_t key, const CityData& city);
+
+    // Helper: Binary (de)serialization of one city
+    bool readFile(uint64_t key, CityData& out) const;
+    bool writeFile(uint64_t key, const CityData& city) const;
+};
+
+#endif // CITY_CACHE_H
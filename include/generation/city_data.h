@@ -0,0 +1,52 @@
+#ifndef CITY_DATA_H
+#define CITY_DATA_H
+
+#include <vector>
+#include "core/city_config.h"
+#include "generation/road_generator.h"
+#include "generation/road_graph.h"
+#include "utils/algorithms.h"
+
+// Building types based on height
+enum BuildingType {
+    LOW_RISE,      // 1-3 floors (residential)
+    MID_RISE,      // 4-10 floors (commercial)
+    HIGH_RISE      // 11+ floors (skyscrapers)
+};
+
+// Structure to represent a 3D building
+struct Building {
+    float x, y;           // Base position (center of building)
+    float width;          // X-axis dimension
+    float depth;          // Y-axis dimension
+    float height;         // Z-axis dimension (vertical)
+    BuildingType type;    // Building classification
+    
+    Building(float px, float py, float w, float d, float h, BuildingType t)
+        : x(px), y(py), width(w), depth(d), height(h), type(t) {}
+};
+
+// Structure to hold all generated city elements
+struct CityData {
+    std::vector<Road> roads;
+    RoadGraph roadGraph;                       // Junctions and connectivity of roads
+    std::vector<Circle> parks;                 // Each park is an analytic circle
+    Circle fountain;                           // Central fountain (separate for different color)
+    std::vector<Building> buildings;           // 3D buildings
+    WorldExtent world;                         // Extent the city was generated in
+    bool isGenerated;
+    
+    CityData() : isGenerated(false) {}
+    
+    void clear() {
+        roads.clear();
+        roadGraph.clear();
+        parks.clear();
+        fountain = Circle();
+        buildings.clear();
+        world = WorldExtent();
+        isGenerated = false;
+    }
+};
+
+#endif // CITY_DATA_H
@@ -2,47 +2,17 @@
 #define CITY_GENERATOR_H
 
 #include <vector>
+#include <random>
+#include <atomic>
 #include "core/city_config.h"
+#include "generation/city_data.h"
+#include "generation/city_cache.h"
+#include "generation/city_stream.h"
+#include "generation/generation_pipeline.h"
+#include "generation/generation_profiler.h"
 #include "generation/road_generator.h"
-#include "utils/algorithms.h"
-
-// Building types based on height
-enum BuildingType {
-    LOW_RISE,      // 1-3 floors (residential)
-    MID_RISE,      // 4-10 floors (commercial)
-    HIGH_RISE      // 11+ floors (skyscrapers)
-};
-
-// Structure to represent a 3D building
-struct Building {
-    float x, y;           // Base position (center of building)
-    float width;          // X-axis dimension
-    float depth;          // Y-axis dimension
-    float height;         // Z-axis dimension (vertical)
-    BuildingType type;    // Building classification
-    
-    Building(float px, float py, float w, float d, float h, BuildingType t)
-        : x(px), y(py), width(w), depth(d), height(h), type(t) {}
-};
-
-// Structure to hold all generated city elements
-struct CityData {
-    std::vector<Road> roads;
-    std::vector<std::vector<Point>> parks;     // Each park is a vector of points
-    std::vector<Point> fountain;               // Central fountain (separate for different color)
-    std::vector<Building> buildings;           // 3D buildings
-    bool isGenerated;
-    
-    CityData() : isGenerated(false) {}
-    
-    void clear() {
-        roads.clear();
-        parks.clear();
-        fountain.clear();
-        buildings.clear();
-        isGenerated = false;
-    }
-};
+#include "generation/spatial_grid.h"
+#include "generation/occupancy_grid.h"
 
 // City Generator Class
 // Manages the overall city generation process
@@ -50,14 +20,61 @@ class CityGenerator {
 private:
     RoadGenerator roadGen;
     CityData cityData;
-    int screenWidth;
-    int screenHeight;
+    SpatialGrid obstacleGrid;   // Broadphase index over parks, roads and buildings
+    float maxRoadHalfWidth;     // Widest road half-width, bounds road collision queries
+    OccupancyGrid occupancy;    // Bitmap of blocked pixels (RASTER backend only)
+    CirclePatternCache circlePatterns;  // Disc spans per radius, cleared for each city
+    CollisionBackend collisionBackend;
+    CityCache cache;            // Previously generated cities by config hash
+    GenerationPipeline pipeline;    // Which stages are up to date with which config
+    std::vector<Road> roadLayout;   // Road centre lines before clipping (ROAD_LAYOUT output)
+    int worldWidth;             // World extent of the current city
+    int worldHeight;
+    float edgeMargin;           // Buildings stay this far inside the world edges
+    float unit;                 // World units per district pixel (CityConfig::worldUnit())
+    size_t progressStride;      // Buildings between progress messages
+    size_t buildingTarget;      // Buildings requested in the current run
+    StageMask lastChanges;      // Stages whose output changed in the last generateCity()
+    const std::atomic<bool>* cancelFlag;    // Set by another thread to stop the current run
+    std::atomic<float> progress;            // Fraction of the current run done (0-1)
+    CityStream* stream;         // Receives the city piece by piece, if set
+    size_t streamedBuildings;   // Buildings already published to the stream
+    bool previewHeights;        // Stream buildings with heights rolled ahead of HEIGHTS
+    std::mt19937 previewRng;    // Mirrors the HEIGHTS stream for those previews
+    SkylineType previewSkyline;
+    GenerationProfile profile;  // Timers and counters of the last generateCity()
     
 public:
-    CityGenerator(int width, int height);
+    CityGenerator();
+    
+    // Generate a complete city based on configuration. A config (and seed)
+    // seen before is served from the cache instead of being regenerated;
+    // otherwise only the stages affected by config changes since the last
+    // city are rerun (see GenerationPipeline).
+    //
+    // When cancel is given, another thread may set it to stop generation at
+    // the next checkpoint. Returns false if it did; the city is then
+    // incomplete and is not cached, and the stages that were cut short run
+    // again next time.
+    bool generateCity(const CityConfig& config, const std::atomic<bool>* cancel = nullptr);
     
-    // Generate a complete city based on configuration
-    void generateCity(const CityConfig& config);
+    // Stages whose output changed in the last generateCity() call; only
+    // these are streamed. After a cancelled call these are the stages that
+    // may have changed.
+    StageMask getChangedStages() const { return lastChanges; }
+    
+    // How far the current generateCity() call has got (0-1). Safe to read
+    // from other threads while it runs.
+    float getProgress() const { return progress.load(std::memory_order_relaxed); }
+    
+    // Publish every city to a stream as it is generated: parks and roads as
+    // their stages finish, buildings in batches while they are placed. Only
+    // the parts that changed are sent again.
+    void setStream(CityStream* cityStream) { stream = cityStream; }
+    
+    // Timings and counters of the last generateCity() call. Only valid
+    // between calls; read it from the thread that generates.
+    const GenerationProfile& getProfile() const { return profile; }
     
     // Get the generated city data
     const CityData& getCityData() const { return cityData; }
@@ -66,14 +83,75 @@ public:
     bool hasCity() const { return cityData.isGenerated; }
     
 private:
+    // Run the out-of-date generation stages for a config that is not in the
+    // cache. Returns false if cancelled.
+    bool buildCity(const CityConfig& config);
+    
+    // Whether the caller of generateCity() asked for it to stop
+    bool cancelled() const { return cancelFlag && cancelFlag->load(std::memory_order_relaxed); }
+    
+    // Publish progress as a fraction of one stage
+    void reportProgress(GenerationStage stage, float fraction);
+    
+    // Send the parks and fountain to the stream
+    void streamParks();
+    
+    // Send the clipped roads to the stream
+    void streamRoads();
+    
+    // Start sending buildings again from the first one. Without
+    // heightsAssigned, each building is sent with the height the HEIGHTS
+    // stage is going to give it.
+    void beginBuildingStream(const CityConfig& config, bool heightsAssigned);
+    
+    // Send the buildings added since the last call
+    void streamNewBuildings();
+    
     // Generate parks using Midpoint Circle Algorithm
     void generateParks(const CityConfig& config);
     
-    // Generate buildings based on configuration and available space
+    // Rebuild the obstacle grid (and raster) from the current parks and roads
+    void indexObstacles(const CityConfig& config);
+    
+    // Find road junctions and connectivity (see RoadGraph)
+    void buildRoadGraph();
+    
+    // Generate building footprints based on configuration and available space
     void generateBuildings(const CityConfig& config);
     
-    // Helper function to check if a position overlaps with roads or parks
-    bool isValidBuildingPosition(float x, float y, float width, float depth) const;
+    // Roll the height and type of every building
+    void assignHeights(const CityConfig& config);
+    
+    // Place buildings by blind rejection sampling (RANDOM mode)
+    void placeBuildingsRandom(const CityConfig& config, std::mt19937& rng);
+    
+    // Place buildings by Bridson-style Poisson-disk sampling (POISSON_DISK mode)
+    void placeBuildingsPoissonDisk(const CityConfig& config, std::mt19937& rng);
+    
+    // Place buildings on worker threads, one tile per job, in four phases of
+    // non-adjacent tiles (PARALLEL_TILES mode)
+    void placeBuildingsTiled(const CityConfig& config, uint32_t baseSeed);
+    
+    // Cut the blocks between roads into lots and put one building in each,
+    // with no collision tests (BLOCK_LOTS mode)
+    void placeBuildingsInLots(const CityConfig& config, std::mt19937& rng);
+    
+    // Place up to quota buildings inside one tile without modifying the city,
+    // counting every candidate in counts. Safe to call concurrently for tiles
+    // that are not adjacent.
+    std::vector<Building> fillTile(float minX, float minY, float maxX, float maxY, int quota,
+                                   const CityConfig& config, std::mt19937& rng,
+                                   PlacementCounts& counts) const;
+    
+    // Try to place one building centred at (x, y); returns true if it was added
+    bool tryPlaceBuilding(float x, float y, const CityConfig& config, std::mt19937& rng);
+    
+    // Add a building to the city and the collision structures
+    void addBuilding(const Building& building);
+    
+    // Helper function to check if a position overlaps with roads or parks.
+    // Returns what the building would be too close to, or NONE if it fits.
+    PlacementRejection checkBuildingPosition(float x, float y, float width, float depth) const;
 };
 
 #endif // CITY_GENERATOR_H
@@ -0,0 +1,76 @@
+#ifndef CITY_STREAM_H
+#define CITY_STREAM_H
+
+#include <atomic>
+#include <deque>
+#include <vector>
+#include "core/city_config.h"
+#include "generation/city_data.h"
+#include "utils/spsc_queue.h"
+
+// Which part of the city a batch carries
+enum class CityBatchKind {
+    PARKS,      // All parks and the fountain
+    ROADS,      // Some clipped roads
+    BUILDINGS   // Some buildings, with the heights they will end up with
+};
+
+// A piece of a city on its way from the generator to the renderer
+struct CityBatch {
+    CityBatchKind kind;
+    bool restart;                       // Replaces what was sent for this kind before
+    WorldExtent world;                  // Extent the elements are placed in
+    std::vector<Circle> parks;          // PARKS
+    Circle fountain;                    // PARKS
+    std::vector<Road> roads;            // ROADS
+    bool lastRoads;                     // ROADS: completes the road set
+    RoadGraph roadGraph;                // ROADS: graph of the whole set, on the last batch only
+    std::vector<Building> buildings;    // BUILDINGS
+
+    CityBatch() : kind(CityBatchKind::PARKS), restart(false), lastRoads(false) {}
+    CityBatch(CityBatchKind k, bool r, const WorldExtent& w) : kind(k), restart(r), world(w), lastRoads(false) {}
+};
+
+// City Stream
+// Hands a city to the renderer piece by piece while it is being generated,
+// so large cities appear progressively instead of all at once at the end.
+//
+// The generator thread publishes batches and the render thread receives
+// them through a lock-free single-producer/single-consumer queue. Applying
+// every batch in order always yields the generator's latest output: a
+// restart batch replaces its kind wholesale, anything else is appended.
+//
+// Publishing never blocks generation. Batches that do not fit in the queue
+// wait in a producer-side backlog, where consecutive building batches are
+// merged; flush() at the end of a run pushes out whatever is left.
+class CityStream {
+private:
+    static const size_t CAPACITY = 64;
+
+    SpscQueue<CityBatch, CAPACITY> queue;
+    std::deque<CityBatch> backlog;      // Producer only: batches waiting for room
+    std::atomic<bool> closed;           // No consumer any more; stop waiting for one
+
+public:
+    CityStream();
+
+    // Producer: queue a batch without waiting
+    void publish(CityBatch&& batch);
+
+    // Producer: wait until every published batch is in the queue. Gives up
+    // if the stream is closed.
+    void flush();
+
+    // Release a producer stuck in flush() (e.g. on shutdown)
+    void close();
+
+    // Consumer: take the oldest batch, if any
+    bool receive(CityBatch& batch) { return queue.tryPop(batch); }
+
+private:
+    // Producer: move backlog batches into the queue while there is room.
+    // Returns true once the backlog is empty.
+    bool drainBacklog();
+};
+
+#endif // CITY_STREAM_H
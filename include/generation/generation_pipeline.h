@@ -0,0 +1,77 @@
+#ifndef GENERATION_PIPELINE_H
+#define GENERATION_PIPELINE_H
+
+#include <cstdint>
+#include "core/city_config.h"
+
+// Stages of city generation, in the order they run
+enum class GenerationStage {
+    PARKS,          // Parks and the central fountain
+    ROAD_LAYOUT,    // Road centre lines for the chosen pattern
+    ROAD_CLIPPING,  // Roads cut around parks, given their width, and the road graph
+    PLACEMENT,      // Building footprints
+    HEIGHTS,        // Building heights and types
+    COUNT
+};
+
+// Set of stages, one bit per GenerationStage
+typedef uint32_t StageMask;
+
+inline StageMask stageBit(GenerationStage stage) {
+    return StageMask(1) << static_cast<int>(stage);
+}
+
+static const StageMask ALL_STAGES = (StageMask(1) << static_cast<int>(GenerationStage::COUNT)) - 1;
+
+// Generation Pipeline
+// Dependency graph of the generation stages. Each stage knows which config
+// fields it reads and which stages it consumes output from, and the
+// pipeline remembers the fields each stage last ran with. A stage only
+// needs to run again when one of its own fields changed or a stage it
+// depends on ran again, so cycling the skyline re-rolls heights alone and
+// changing the road width leaves parks and the road layout untouched.
+//
+// Meshing sits downstream of the pipeline: the renderer rebuilds road
+// meshes after ROAD_CLIPPING, park meshes after PARKS and building meshes
+// after HEIGHTS.
+class GenerationPipeline {
+private:
+    uint64_t fingerprints[static_cast<int>(GenerationStage::COUNT)];
+    StageMask valid;        // Stages whose fingerprint matches their current output
+    StageMask available;    // Stages whose output is still held by the generator
+
+public:
+    GenerationPipeline();
+
+    // Stages whose output a stage consumes
+    static StageMask dependencies(GenerationStage stage);
+
+    // Hash of the config fields a stage reads
+    static uint64_t fingerprint(GenerationStage stage, const CityConfig& config);
+
+    // Stages whose output changes for this config: those with a changed
+    // fingerprint and everything downstream of them
+    StageMask changedStages(const CityConfig& config) const;
+
+    // Stages to run for this config: the changed ones plus any unchanged
+    // stage whose output is no longer held but is needed as input. Rerunning
+    // those reproduces their previous output exactly.
+    StageMask stagesToRun(const CityConfig& config) const;
+
+    // Record that stages ran with this config and hold their output
+    void markRan(StageMask stages, const CityConfig& config);
+
+    // The city was replaced wholesale (e.g. from the cache). Stages in
+    // withOutput hold output for this config; the rest must be rerun
+    // before anything downstream of them can be.
+    void reset(const CityConfig& config, StageMask withOutput);
+
+    // Stages whose run was abandoned part-way: their output is neither
+    // current nor usable as input, so they must run again next time
+    void markStale(StageMask stages);
+
+    // Forget everything; the next run starts from scratch
+    void invalidate();
+};
+
+#endif // GENERATION_PIPELINE_H
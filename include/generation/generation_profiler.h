@@ -0,0 +1,126 @@
+#ifndef GENERATION_PROFILER_H
+#define GENERATION_PROFILER_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include "core/city_config.h"
+
+// Timed parts of generateCity(). Sections nest: GENERATE_CITY covers the
+// whole call, and a stage's time includes the helpers it calls.
+enum class ProfileSection {
+    GENERATE_CITY,      // The whole generateCity() call
+    CACHE_LOOKUP,       // Memory and disk cache lookup
+    PARKS,              // generateParks()
+    ROAD_LAYOUT,        // RoadGenerator::generateRoads()
+    ROAD_CLIPPING,      // RoadGenerator::clipRoads()
+    ROAD_GRAPH,         // buildRoadGraph()
+    OBSTACLE_INDEX,     // indexObstacles()
+    PLACEMENT,          // generateBuildings()
+    HEIGHTS,            // assignHeights()
+    STREAM_FLUSH,       // Waiting for the renderer to take the last batches
+    CACHE_STORE,        // Memory and disk cache store
+    COUNT
+};
+
+// Why a candidate building position was turned down
+enum class PlacementRejection {
+    NONE,       // Accepted
+    EDGE,       // Too close to the world edge
+    BUILDING,   // Too close to another building
+    PARK,       // Too close to a park
+    FOUNTAIN,   // Too close to the fountain
+    ROAD,       // Too close to a road
+    OCCUPIED,   // Blocked in the occupancy raster, which does not record by what
+    COUNT
+};
+
+// Time and memory spent in one section
+struct SectionTiming {
+    double milliseconds;
+    uint64_t bytesAllocated;    // Total size of heap allocations, not net growth
+    int calls;
+
+    SectionTiming() : milliseconds(0.0), bytesAllocated(0), calls(0) {}
+};
+
+// Outcome of every candidate position tried by building placement
+struct PlacementCounts {
+    uint64_t attempts;
+    uint64_t placed;
+    uint64_t rejected[static_cast<int>(PlacementRejection::COUNT)];   // By cause; NONE stays 0
+
+    PlacementCounts() { clear(); }
+
+    void clear();
+
+    // Count one candidate: placed if cause is NONE, rejected otherwise
+    void record(PlacementRejection cause);
+
+    // Add counts gathered separately (e.g. by a worker thread)
+    void merge(const PlacementCounts& other);
+};
+
+// Generation Profile
+// Timers and counters for the last generateCity() call, so the cost of each
+// stage can be measured instead of guessed. Times come from steady_clock;
+// allocated bytes from a counting global operator new, in builds that enable
+// it (see allocationsCounted()).
+struct GenerationProfile {
+    CityConfig config;          // What was generated
+    bool cacheHit;
+    bool cancelled;
+    SectionTiming sections[static_cast<int>(ProfileSection::COUNT)];
+    PlacementCounts placement;
+    uint64_t occupancyPixelsStamped;    // Pixels stamped into the occupancy raster (RASTER backend)
+    uint64_t lotShortfall;      // BLOCK_LOTS: requested buildings there were no lots for
+    uint64_t helperBytes;       // Allocated on helper threads (e.g. tile workers) so far
+
+    GenerationProfile() : cacheHit(false), cancelled(false), occupancyPixelsStamped(0), lotShortfall(0), helperBytes(0) {}
+
+    // Start a new profile for a config
+    void begin(const CityConfig& cityConfig);
+
+    const SectionTiming& section(ProfileSection s) const { return sections[static_cast<int>(s)]; }
+
+    // Report as a JSON object. Sections that did not run are left out.
+    std::string toJson() const;
+
+    // Write the JSON report to a file; returns false if it could not be written
+    bool saveJson(const std::string& path) const;
+
+    static const char* sectionName(ProfileSection s);
+    static const char* rejectionName(PlacementRejection cause);
+};
+
+// Whether this build replaces the global allocation functions to count heap
+// bytes (COUNT_ALLOCATIONS, see allocation_counter.cpp). Without it every
+// byte count is 0.
+bool allocationsCounted();
+
+// Bytes allocated with operator new by the calling thread since it started
+uint64_t threadAllocatedBytes();
+
+// Profile Scope
+// Adds the time and allocations between construction and destruction to a
+// section of a profile.
+class ProfileScope {
+private:
+    GenerationProfile& profile;
+    ProfileSection section;
+    std::chrono::steady_clock::time_point start;
+    uint64_t startBytes;
+
+public:
+    ProfileScope(GenerationProfile& target, ProfileSection s);
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    // Allocations on this thread plus those reported from helper threads
+    uint64_t allocatedBytes() const { return threadAllocatedBytes() + profile.helperBytes; }
+};
+
+#endif // GENERATION_PROFILER_H
@@ -0,0 +1,67 @@
+#ifndef GENERATION_WORKER_H
+#define GENERATION_WORKER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "core/city_config.h"
+#include "generation/city_generator.h"
+#include "generation/city_stream.h"
+
+// Generation Worker
+// Runs CityGenerator on a background thread so the render loop keeps
+// drawing while a large city is generated.
+//
+// The generator builds into its own CityData (the back buffer) and streams
+// each piece to the render thread as soon as it exists (see CityStream),
+// where the renderer assembles its own copy (the front buffer). A request
+// made while another is running cancels it; the newest request is always
+// the one that ends up on screen.
+class GenerationWorker {
+private:
+    CityGenerator generator;        // Only used on the worker thread
+    CityStream stream;              // Generator to render thread
+    std::thread thread;
+
+    std::mutex mutex;               // Guards everything below up to 'hasProfile'
+    std::condition_variable wake;
+    CityConfig pendingConfig;       // Newest request not yet started
+    bool hasPending;
+    bool stopping;
+    GenerationProfile lastProfile;  // Profile of the last run that ended
+    bool hasProfile;
+
+    std::atomic<bool> cancelRequested;  // Polled by the generator
+    std::atomic<bool> busy;             // A request is queued or running
+
+public:
+    GenerationWorker();
+    ~GenerationWorker();
+
+    GenerationWorker(const GenerationWorker&) = delete;
+    GenerationWorker& operator=(const GenerationWorker&) = delete;
+
+    // Queue a city for generation, superseding (and cancelling) any request
+    // that has not finished yet. The config is copied.
+    void request(const CityConfig& config);
+
+    // Pieces of the city being generated, for the render thread to receive
+    CityStream& getStream() { return stream; }
+
+    // Whether a request is queued or running
+    bool isBusy() const { return busy.load(); }
+
+    // Progress of the running request (0-1)
+    float getProgress() const { return generator.getProgress(); }
+
+    // Copy the profile of the last finished or cancelled run. Returns false
+    // if nothing has run yet.
+    bool getProfile(GenerationProfile& out);
+
+private:
+    // Worker thread: run requests until the worker is destroyed
+    void run();
+};
+
+#endif // GENERATION_WORKER_H
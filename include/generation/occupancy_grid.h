@@ -0,0 +1,59 @@
+#ifndef OCCUPANCY_GRID_H
+#define OCCUPANCY_GRID_H
+
+#include <vector>
+#include <cstdint>
+#include "utils/algorithms.h"
+
+// Bit-Packed Occupancy Raster
+// One bit per pixel, packed 64 pixels to a word along each row. Obstacles
+// are stamped in already grown by their clearance buffer, so a candidate
+// building only needs its exact footprint tested: a few word-wide AND
+// operations per row instead of geometric tests against nearby elements.
+//
+// Pixel (x, y) covers [x, x+1) x [y, y+1). Shapes are rasterized
+// conservatively (every pixel they touch is set), so the raster can only
+// reject more than the exact geometric test, never less.
+class OccupancyGrid {
+private:
+    int width;
+    int height;
+    int wordsPerRow;
+    std::vector<uint64_t> bits;
+    uint64_t stampedPixels;     // Pixels written by stamps since the last reset
+
+public:
+    OccupancyGrid();
+
+    // Clear all bits and resize to width x height pixels
+    void reset(int width, int height);
+
+    // Mark an axis-aligned rectangle as occupied
+    void stampRect(float minX, float minY, float maxX, float maxY);
+
+    // Mark horizontal pixel runs as occupied, grown by pad pixels on every
+    // side (Minkowski sum with a square). For a disc this matches the "box
+    // grown by buffer vs circle grown by buffer" placement rule. The runs
+    // must be one per row on consecutive rows, top row first, as
+    // midpointDiscSpans() returns them.
+    void stampSpans(const PixelSpan* spans, size_t count, int pad = 0);
+
+    // Mark every pixel within halfWidth of the segment (a capsule) as occupied
+    void stampThickSegment(float x0, float y0, float x1, float y1, float halfWidth);
+
+    // Check whether every pixel of a rectangle is free
+    bool isRectFree(float minX, float minY, float maxX, float maxY) const;
+
+    // Pixels written by stamps since the last reset, counting a pixel again
+    // each time a stamp covers it
+    uint64_t getStampedPixels() const { return stampedPixels; }
+
+private:
+    // Helper: Set bits [x0, x1] (inclusive, clamped) in row y
+    void fillSpan(int y, int x0, int x1);
+
+    // Helper: Inclusive, clamped pixel row range covered by [minY, maxY]
+    bool rowRange(float minY, float maxY, int& y0, int& y1) const;
+};
+
+#endif // OCCUPANCY_GRID_H
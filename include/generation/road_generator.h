@@ -7,32 +7,61 @@
 #include "core/city_config.h"
 
 // Structure to represent a road segment
+// A road is stored in vector form: the two endpoints of its centre line plus
+// the parametric interval [tStart, tEnd] of that line which is kept after
+// clipping. Both views mesh this segment directly; placement tests it
+// analytically or stamps it into the occupancy raster.
 struct Road {
-    std::vector<Point> points;  // Points along the road (from Bresenham)
+    Point start;                // First endpoint of the underlying line
+    Point end;                  // Second endpoint of the underlying line
+    float tStart;               // Start of the kept interval along start->end (0-1)
+    float tEnd;                 // End of the kept interval along start->end (0-1)
     int width;                  // Width of the road in pixels
     
-    Road() : width(8) {}
-    Road(const std::vector<Point>& pts, int w) : points(pts), width(w) {}
+    Road() : tStart(0.0f), tEnd(1.0f), width(8) {}
+    Road(const Point& a, const Point& b, int w, float t0 = 0.0f, float t1 = 1.0f)
+        : start(a), end(b), tStart(t0), tEnd(t1), width(w) {}
+    
+    // Endpoints of the kept interval in pixel coordinates
+    float x0() const { return start.x + (end.x - start.x) * tStart; }
+    float y0() const { return start.y + (end.y - start.y) * tStart; }
+    float x1() const { return start.x + (end.x - start.x) * tEnd; }
+    float y1() const { return start.y + (end.y - start.y) * tEnd; }
+    
+    // Length of the kept interval in pixels
+    float length() const;
 };
 
 // Road Generator Class
-// Generates different road patterns using Bresenham's Line Algorithm
+// Generates different road patterns as line segments
 class RoadGenerator {
 private:
-    int screenWidth;
-    int screenHeight;
+    static constexpr float RING_CHORD_TOLERANCE = 1.0f;  // Max arc-to-chord gap in district pixels
+    static constexpr int MIN_RING_SEGMENTS = 8;
+    static constexpr float ORGANIC_JITTER = 0.7f;        // Share of a cell a node may wander
+    static constexpr float ORGANIC_EXTRA_EDGES = 0.35f;  // Share of non-tree edges kept
+    static constexpr float ORGANIC_MAX_EDGE = 2.0f;      // Longest extra edge, in cell sizes
+    
+    int worldWidth;    // World extent of the current city
+    int worldHeight;
+    int margin;        // Border kept free of roads
+    float unit;        // World units per district pixel (CityConfig::worldUnit())
+    int roadWidth;     // Road width in world units (CityConfig::worldRoadWidth())
     std::mt19937 rng;  // Random number generator
     
 public:
-    RoadGenerator(int width, int height);
+    RoadGenerator();
+    
+    // Reseed the generator; call before each city for reproducible roads
+    void seed(uint32_t value) { rng.seed(value); }
     
     // Generate roads based on the configuration
     std::vector<Road> generateRoads(const CityConfig& config);
     
-    // Generate roads avoiding parks and fountains
-    std::vector<Road> generateRoadsAvoidingObstacles(const CityConfig& config, 
-                                                       const std::vector<std::vector<Point>>& parks,
-                                                       const std::vector<Point>& fountain);
+    // Cut a road layout around parks and fountains and give it its width
+    std::vector<Road> clipRoads(const std::vector<Road>& layout, int width,
+                                const std::vector<Circle>& parks,
+                                const Circle& fountain);
     
 private:
     // Generate grid-based road network
@@ -44,11 +73,18 @@ private:
     // Generate random road network
     std::vector<Road> generateRandomRoads(const CityConfig& config);
     
-    // Helper: Create a road between two points using Bresenham's algorithm
+    // Generate organic road network (Delaunay triangulation thinned to a
+    // spanning tree plus a share of its shortest remaining edges)
+    std::vector<Road> generateOrganicRoads(const CityConfig& config);
+    
+    // Helper: Append a ring as an arc polyline, clipped to the city bounds
+    void appendRingRoad(std::vector<Road>& roads, int centerX, int centerY, int radius, int width);
+    
+    // Helper: Create a road segment between two points
     Road createRoad(int x0, int y0, int x1, int y1, int width);
     
-    // Helper: Generate random position within screen bounds
-    Point randomPoint(int margin = 50);
+    // Helper: Generate random position within the world, inset by inset
+    Point randomPoint(int inset);
 };
 
 #endif // ROAD_GENERATOR_H
@@ -0,0 +1,73 @@
+#ifndef ROAD_GRAPH_H
+#define ROAD_GRAPH_H
+
+#include <vector>
+#include "generation/road_generator.h"
+
+// A place where roads end or meet
+struct RoadNode {
+    float x, y;                 // Position in world units
+    std::vector<int> edges;     // Indices of incident edges
+
+    RoadNode(float px, float py) : x(px), y(py) {}
+};
+
+// A stretch of one road between two nodes, with no junction in between
+struct RoadEdge {
+    int from;           // Node at the tStart end
+    int to;             // Node at the tEnd end
+    int road;           // Index into CityData::roads
+    float tStart;       // Sub-interval of that road's underlying line (0-1)
+    float tEnd;
+
+    RoadEdge(int a, int b, int r, float t0, float t1)
+        : from(a), to(b), road(r), tStart(t0), tEnd(t1) {}
+};
+
+// Road Network Graph
+// Roads are generated as independent segments, so crossings between them
+// are implicit. The graph makes them explicit: nodes sit at road ends and
+// at every point where two or more roads meet, and each road is split into
+// edges between consecutive nodes along it.
+//
+// Meeting points are found with a Bentley-Ottmann sweep in
+// O((n + k) log n) for n roads and k meeting points, rather than testing
+// every pair of roads.
+class RoadGraph {
+private:
+    std::vector<RoadNode> nodes;
+    std::vector<RoadEdge> edges;
+    std::vector<int> component;     // Connected component of each node
+    int componentTotal;
+    int crossingTotal;              // Nodes interior to at least one road
+
+public:
+    RoadGraph();
+
+    // Rebuild the graph for a set of roads (their kept intervals)
+    void build(const std::vector<Road>& roads);
+
+    void clear();
+
+    const std::vector<RoadNode>& getNodes() const { return nodes; }
+    const std::vector<RoadEdge>& getEdges() const { return edges; }
+
+    // Number of nodes where a road is crossed or joined mid-way, as opposed
+    // to places where roads only share an end
+    int crossingCount() const { return crossingTotal; }
+
+    // Number of separate road networks
+    int componentCount() const { return componentTotal; }
+
+    // Whether two nodes can be reached from each other along roads
+    bool connected(int nodeA, int nodeB) const;
+
+    // Connected component a node belongs to, in [0, componentCount())
+    int componentOf(int node) const { return component[node]; }
+
+    // Node closest to a point, or -1 if the graph is empty. Linear scan;
+    // meant for occasional queries, not per-frame use.
+    int nearestNode(float x, float y) const;
+};
+
+#endif // ROAD_GRAPH_H
@@ -0,0 +1,74 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <vector>
+
+// Kinds of city elements tracked by the spatial grid
+enum class GridEntryKind {
+    BUILDING,   // Placed building footprint
+    PARK,       // Circular park
+    FOUNTAIN,   // Central fountain
+    ROAD        // Road segment
+};
+
+// A reference to one city element stored in a grid cell
+struct GridEntry {
+    GridEntryKind kind;
+    int index;      // Index into the matching CityData container
+    int sub;        // Optional sub-element index, -1 if unused
+
+    GridEntry(GridEntryKind k, int i, int s = -1) : kind(k), index(i), sub(s) {}
+};
+
+// Uniform Grid Spatial Index
+// Buckets city elements by the cells their bounding boxes overlap so that
+// collision checks only visit elements near the query region instead of
+// every element placed so far.
+class SpatialGrid {
+private:
+    float cellSize;
+    int cols;
+    int rows;
+    std::vector<std::vector<GridEntry>> cells;
+
+public:
+    SpatialGrid();
+
+    // Clear all entries and resize the grid to cover a width x height area
+    void reset(int width, int height, float cellSize);
+
+    // Insert an entry into every cell overlapped by the given bounding box
+    void insert(const GridEntry& entry, float minX, float minY, float maxX, float maxY);
+
+    // Insert an entry into every cell touched by a segment thickened by radius.
+    // Unlike insert() on the segment's bounding box this only covers the cells
+    // along the segment, which matters for long diagonal roads.
+    void insertSegment(const GridEntry& entry, float x0, float y0, float x1, float y1, float radius);
+
+    // Visit every entry whose cells overlap the given bounding box.
+    // The visitor returns false to stop the search early; forEachInRange then
+    // returns false as well. Entries spanning several cells may be visited
+    // more than once, so visitors must be idempotent.
+    template <typename Visitor>
+    bool forEachInRange(float minX, float minY, float maxX, float maxY, Visitor visit) const {
+        int c0, r0, c1, r1;
+        cellRange(minX, minY, maxX, maxY, c0, r0, c1, r1);
+        for (int r = r0; r <= r1; r++) {
+            for (int c = c0; c <= c1; c++) {
+                for (const auto& entry : cells[r * cols + c]) {
+                    if (!visit(entry)) {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    // Helper: Convert a bounding box to an inclusive, clamped cell range
+    void cellRange(float minX, float minY, float maxX, float maxY,
+                   int& c0, int& r0, int& c1, int& r1) const;
+};
+
+#endif // SPATIAL_GRID_H
@@ -4,7 +4,7 @@
  * 
  * Manages all rendering operations for the city including:
  * - VAO/VBO buffer management
- * - Mesh creation and updates
+ * - Mesh creation from streamed city batches
  * - Draw calls for all city elements
  * - Texture binding
  * - 2D/3D rendering modes
@@ -17,8 +17,11 @@
 #define CITY_RENDERER_H
 
 #include <glad/glad.h>
+#include <chrono>
+#include <deque>
 #include <vector>
-#include "generation/city_generator.h"
+#include "generation/city_stream.h"
+#include "rendering/mesh/building_mesh.h"
 #include "rendering/shaders/shader_manager.h"
 #include "core/city_config.h"
 
@@ -31,15 +34,32 @@
  * - Separate 2D point rendering and 3D mesh rendering
  * - Automatic buffer cleanup and regeneration
  * - Texture-based rendering for 3D mode
+ * 
+ * Each kind of element is packed into one large buffer and drawn with a
+ * single multi-draw call, so the draw call count does not grow with the
+ * size of the city. Buildings are one shared box mesh drawn with hardware
+ * instancing: each building only adds a small BuildingInstance record.
+ * 
+ * Roads are joined at junctions (see roadNetworkTo3DMesh()) so crossings
+ * are drawn once instead of as overlapping, z-fighting quads.
+ * 
+ * The city arrives in batches from a CityStream while it is generated.
+ * Batches are meshed and appended to the buffers a few milliseconds' worth
+ * per frame, so a large city appears progressively without stalling the
+ * render loop. The renderer keeps its own copy of everything received,
+ * which is what it draws from and re-meshes when the view mode changes.
  */
 class CityRenderer {
 public:
     /**
      * @brief Construct a new City Renderer
-     * @param screenWidth Window width in pixels
-     * @param screenHeight Window height in pixels
+     * @param framebufferWidth Width of the framebuffer in pixels
+     * @param framebufferHeight Height of the framebuffer in pixels
+     * 
+     * Meshes are built in the world extent stored with each city. Only the
+     * 2D road quads depend on the framebuffer, to keep them two pixels wide.
      */
-    CityRenderer(int screenWidth, int screenHeight);
+    CityRenderer(int framebufferWidth, int framebufferHeight);
     
     /**
      * @brief Destroy the City Renderer and cleanup all buffers
@@ -47,18 +67,32 @@ public:
     ~CityRenderer();
     
     /**
-     * @brief Update rendering data when city changes or view mode changes
-     * @param city City data to render
+     * @brief Receive new batches and mesh as many as the frame budget allows
+     * @param stream Stream the generator publishes to
+     * 
+     * Call once per frame. Batches that do not fit in this frame's budget
+     * are meshed on later calls, in order. A restart batch replaces the
+     * buffers of its element group; other batches append to them.
+     */
+    void consumeStream(CityStream& stream);
+    
+    /**
+     * @brief Switch view mode, rebuilding every buffer if it changed
      * @param view3D Whether to use 3D rendering mode
+     */
+    void setViewMode(bool view3D);
+    
+    /**
+     * @brief Track the framebuffer size, rebuilding the 2D road quads if it changed
+     * @param width Width of the framebuffer in pixels
+     * @param height Height of the framebuffer in pixels
      * 
-     * Regenerates all VAO/VBO buffers for the current city and view mode.
-     * Automatically cleans up old buffers before creating new ones.
+     * Call once per frame. A zero size (minimized window) is ignored.
      */
-    void updateCity(const CityData& city, bool view3D);
+    void setFramebufferSize(int width, int height);
     
     /**
      * @brief Render the city
-     * @param city City data
      * @param config City configuration (includes texture theme)
      * @param view3D Whether to use 3D mode
      * @param shaderManager Shader manager for rendering
@@ -69,106 +103,222 @@ public:
      * @param grassTexture Texture ID for grass/parks
      * @param fountainTexture Texture ID for fountains
      */
-    void render(const CityData& city, const CityConfig& config, bool view3D, ShaderManager& shaderManager,
+    void render(const CityConfig& config, bool view3D, ShaderManager& shaderManager,
                 GLuint brickTexture, GLuint concreteTexture, GLuint glassTexture,
                 GLuint roadTexture, GLuint grassTexture, GLuint fountainTexture);
     
     /**
      * @brief Check if rendering data is ready
-     * @return true if buffers are created and ready to render
+     * @return true once any part of a city has been received
      */
-    bool isReady() const { return !VAOs.empty(); }
+    bool isReady() const { return ready; }
     
 private:
-    // Screen dimensions
-    int screenWidth;
-    int screenHeight;
+    /**
+     * @struct MeshGroup
+     * @brief Meshes of one kind of city element, packed into one buffer
+     * 
+     * Meshes are appended back to back into a single VBO with one VAO, and
+     * each keeps its range of vertices for multi-draw calls. The buffer
+     * grows by doubling and survives clearing, so clearing a group costs
+     * nothing and refilling it does not reallocate.
+     */
+    struct MeshGroup {
+        bool hasTexCoords;              ///< 5 floats per vertex (position + UV) instead of 3
+        GLuint VAO;
+        GLuint VBO;
+        GLsizei capacity;               ///< Vertices the buffer has room for
+        GLsizei vertexCount;            ///< Vertices in use
+        std::vector<GLint> firsts;      ///< First vertex of each mesh
+        std::vector<GLsizei> counts;    ///< Vertices in each mesh
+        
+        explicit MeshGroup(bool texCoords)
+            : hasTexCoords(texCoords), VAO(0), VBO(0), capacity(0), vertexCount(0) {}
+    };
     
-    // 2D point rendering buffers (for 2D mode)
-    std::vector<GLuint> VAOs;
-    std::vector<GLuint> VBOs;
-    std::vector<int> vertexCounts;
+    // 2D point rendering buffers (for 2D mode); roads are 2-pixel quads
+    MeshGroup roads2D;
+    MeshGroup parks2D;
+    MeshGroup fountain2D;
     
-    // 3D mesh rendering buffers - Roads
-    std::vector<GLuint> road3DVAOs;
-    std::vector<GLuint> road3DVBOs;
-    std::vector<int> road3DVertexCounts;
+    // 3D mesh rendering buffers
+    MeshGroup roads3D;
+    MeshGroup parks3D;
+    MeshGroup fountain3D;
     
-    // 3D mesh rendering buffers - Parks
-    std::vector<GLuint> park3DVAOs;
-    std::vector<GLuint> park3DVBOs;
-    std::vector<int> park3DVertexCounts;
+    // Buildings: the unit box (2D or 3D depending on view mode) drawn once
+    // per instance record, all in one glDrawElementsInstanced call
+    static const int BUILDING_TYPE_COUNT = 3;
+    GLuint buildingVAO;
+    GLuint buildingMeshVBO;         ///< unitBuildingVertices() for meshView3D
+    GLuint buildingIndexBuffer;     ///< BUILDING_INDICES
+    GLuint buildingInstanceVBO;     ///< One BuildingInstance per shown building, in order
+    GLsizei instanceCapacity;       ///< Records the instance buffer has room for
+    GLsizei instanceCount;          ///< Records in use
     
-    // 3D mesh rendering buffers - Fountain
-    GLuint fountain3DVAO;
-    GLuint fountain3DVBO;
-    int fountain3DVertexCount;
+    CityData shown;                 ///< Everything received so far, in buffer order
+    std::deque<CityBatch> incoming; ///< Received batches not meshed yet
+    size_t incomingCursor;          ///< Elements of incoming.front() already meshed
+    bool meshView3D;                ///< View mode the buffers were built for
+    bool ready;                     ///< Whether any batch has been meshed yet
+    bool roadsJoined;               ///< shown.roadGraph is the graph of all of shown.roads
+    int framebufferWidth;           ///< Framebuffer size roads2D was built for
+    int framebufferHeight;
+    
+    // Reused between batches so gathering instances does not allocate
+    std::vector<BuildingInstance> instanceScratch;
     
     /**
      * @brief Cleanup all rendering buffers
      * 
-     * Deletes all VAOs and VBOs, clears arrays.
-     * Called before regenerating buffers or in destructor.
+     * Deletes the buffer and VAO of every group and the shared index
+     * buffer, a fixed number of objects however large the city.
+     * Called in the destructor.
      */
     void cleanup();
     
     /**
-     * @brief Create buffer for a mesh
-     * @param vertices Vertex data (position + optional texture coordinates)
-     * @param hasTexCoords Whether vertices include texture coordinates (5 floats vs 3 floats per vertex)
-     * @return Pair of (VAO, VBO) handles
+     * @brief Empty a group, keeping its buffer for reuse
+     * @param group Group to clear
+     */
+    void clearGroup(MeshGroup& group);
+    
+    /**
+     * @brief Drop every building instance, keeping the buffers for reuse
+     */
+    void clearBuildings() { instanceCount = 0; }
+    
+    /**
+     * @brief Delete the buffer and VAO of a group
+     * @param group Group to release
+     */
+    void releaseGroup(MeshGroup& group);
+    
+    /**
+     * @brief Append a mesh to a group's buffer
+     * @param group Group to append to
+     * @param vertices Vertex data in the group's format (3 or 5 floats per vertex)
+     * @return First vertex of the new mesh in the group's buffer
+     */
+    GLint addMesh(MeshGroup& group, const std::vector<float>& vertices);
+    
+    /**
+     * @brief Make room for more vertices in a group's buffer
+     * @param group Group to grow
+     * @param needed Total number of vertices the buffer must hold
+     * 
+     * Creates the VAO on first use. A larger buffer is allocated and the
+     * vertices in use are copied over on the GPU.
+     */
+    void reserveVertices(MeshGroup& group, GLsizei needed);
+    
+    /**
+     * @brief Apply the first batch waiting in 'incoming', within a deadline
+     * @param deadline End of this frame's meshing budget
+     * @return true if the batch was fully applied and time is left for more
+     * 
+     * Road and building batches stop part-way when the time is up and carry
+     * on from incomingCursor on the next call.
+     */
+    bool applyBatch(std::chrono::steady_clock::time_point deadline);
+    
+    /**
+     * @brief Rebuild every buffer from the shown city
+     */
+    void rebuild();
+    
+    /**
+     * @brief Rebuild park and fountain buffers (2D points and 3D meshes)
+     */
+    void meshParks();
+    
+    /**
+     * @brief Rebuild the 2D road quads of every shown road
+     */
+    void meshRoadLines();
+    
+    /**
+     * @brief Append the buffers of one shown road
+     * @param road Road to mesh
+     */
+    void meshRoad(const Road& road);
+    
+    /**
+     * @brief Replace the 3D road quads with the network joined at junctions
+     * 
+     * Roads are meshed one by one while they arrive; once the last road
+     * batch brings the road graph, overlapping quads at junctions are
+     * replaced by trimmed strips and junction patches.
+     */
+    void joinRoads();
+    
+    /**
+     * @brief Create the building VAO with the unit box and index buffer
+     */
+    void createBuildingMesh();
+    
+    /**
+     * @brief Upload the unit box for the current view mode
+     */
+    void uploadBuildingMesh();
+    
+    /**
+     * @brief Make room for more records in the instance buffer
+     * @param needed Total number of records the buffer must hold
+     * 
+     * A larger buffer is allocated and the records in use are copied over
+     * on the GPU.
+     */
+    void reserveInstances(GLsizei needed);
+    
+    /**
+     * @brief Append building instances after the ones already shown
+     * @param instances Records to upload, in shown.buildings order
+     */
+    void addInstances(const std::vector<BuildingInstance>& instances);
+    
+    /**
+     * @brief Draw every mesh of a group with one multi-draw call
+     * @param group Group to draw
+     * @param mode Primitive type (GL_POINTS or GL_TRIANGLES)
      */
-    std::pair<GLuint, GLuint> createBuffer(const std::vector<float>& vertices, bool hasTexCoords);
+    void drawGroup(const MeshGroup& group, GLenum mode);
     
     /**
      * @brief Render roads (both 2D and 3D)
-     * @param city City data
      * @param view3D Render mode
      * @param shaderManager Shader manager
      * @param roadTexture Road texture ID
-     * @param roadCount Number of roads
      */
-    void renderRoads(const CityData& city, bool view3D, ShaderManager& shaderManager,
-                     GLuint roadTexture, size_t roadCount);
+    void renderRoads(bool view3D, ShaderManager& shaderManager, GLuint roadTexture);
     
     /**
      * @brief Render parks (both 2D and 3D)
-     * @param city City data
      * @param view3D Render mode
      * @param shaderManager Shader manager
      * @param grassTexture Grass texture ID
-     * @param roadCount Number of roads (for offset calculation)
-     * @param parkCount Number of parks
      */
-    void renderParks(const CityData& city, bool view3D, ShaderManager& shaderManager,
-                     GLuint grassTexture, size_t roadCount, size_t parkCount);
+    void renderParks(bool view3D, ShaderManager& shaderManager, GLuint grassTexture);
     
     /**
      * @brief Render fountain (both 2D and 3D)
-     * @param city City data
      * @param view3D Render mode
      * @param shaderManager Shader manager
      * @param fountainTexture Fountain texture ID
-     * @param fountainOffset Offset in VAO array
-     * @param fountainCount Number of fountains (0 or 1)
      */
-    void renderFountain(const CityData& city, bool view3D, ShaderManager& shaderManager,
-                        GLuint fountainTexture, size_t fountainOffset, size_t fountainCount);
+    void renderFountain(bool view3D, ShaderManager& shaderManager, GLuint fountainTexture);
     
     /**
      * @brief Render buildings (both 2D and 3D)
-     * @param city City data
      * @param config City configuration (includes texture theme)
      * @param view3D Render mode
      * @param shaderManager Shader manager
      * @param brickTexture Brick texture ID
      * @param concreteTexture Concrete texture ID
      * @param glassTexture Glass texture ID
-     * @param buildingStart Starting index in VAO array
      */
-    void renderBuildings(const CityData& city, const CityConfig& config, bool view3D, ShaderManager& shaderManager,
-                         GLuint brickTexture, GLuint concreteTexture, GLuint glassTexture,
-                         size_t buildingStart);
+    void renderBuildings(const CityConfig& config, bool view3D, ShaderManager& shaderManager,
+                         GLuint brickTexture, GLuint concreteTexture, GLuint glassTexture);
 };
 
 #endif // CITY_RENDERER_H
@@ -2,7 +2,8 @@
  * @file building_mesh.h
  * @brief Building 3D Mesh Generation
  * 
- * Generates 3D cube meshes for buildings with proper UV coordinates for texturing.
+ * Generates the box mesh shared by every building and the per-instance
+ * records that place, size and texture one copy of it per building.
  * Supports both 2D and 3D view modes with appropriate coordinate systems.
  * 
  * @author City Designer Team
@@ -12,18 +13,42 @@
 #ifndef BUILDING_MESH_H
 #define BUILDING_MESH_H
 
+#include <cstdint>
 #include <vector>
 #include "generation/city_generator.h" // For Building struct
 
+/// Vertices in the building mesh (see unitBuildingVertices())
+const int BUILDING_VERTEX_COUNT = 14;
+
+/// Indices in the building mesh: 5 faces * 2 triangles * 3 vertices
+const int BUILDING_INDEX_COUNT = 30;
+
+/**
+ * @brief Triangle indices of the building mesh, as 16-bit values
+ */
+extern const uint16_t BUILDING_INDICES[BUILDING_INDEX_COUNT];
+
 /**
- * @brief Generate 3D cube vertices for a building
+ * @struct BuildingInstance
+ * @brief Per-instance attributes of one building
  * 
- * Creates a 3D cube mesh with 36 vertices (6 faces * 2 triangles * 3 vertices each)
- * in format (x, y, z, u, v) where (u, v) are texture coordinates.
+ * A building is the unit box scaled by 'scale' and moved by 'offset', both
+ * in the view coordinate system the mesh was generated for.
+ */
+struct BuildingInstance {
+    float offset[3];    ///< Centre of the footprint, at ground level
+    float scale[3];     ///< Half width, half depth and full height along the matching axes
+    int32_t material;   ///< BuildingType, selects the texture (3D) or colour (2D)
+};
+
+/**
+ * @brief Generate the vertices of the unit building box
+ * 
+ * Creates BUILDING_VERTEX_COUNT vertices in format (x, y, z, u, v), to be
+ * drawn with BUILDING_INDICES. The footprint spans -1 to 1 and the height
+ * 0 to 1. The bottom face stands on the ground and can never be seen, so
+ * it is left out.
  * 
- * @param building Building structure containing position and dimensions
- * @param screenWidth Width of the viewport in pixels
- * @param screenHeight Height of the viewport in pixels
  * @param is3D If true, uses 3D coordinate system (Y is up); if false, uses 2D system (Z is up)
  * @return std::vector<float> Vertex data with positions and UV coordinates
  * 
@@ -32,11 +57,23 @@
  * - 2D mode: X=left/right, Y=depth, Z=height
  * 
  * Each vertex has 5 floats: (x, y, z, u, v)
- * Total vertices: 36 (6 faces * 6 vertices per face)
+ * Vertices 0-9: wall corners, bottom/top pairs walking round the footprint.
+ *   U keeps counting from wall to wall (0 to 4), so neighbouring walls share
+ *   their corner edge; with GL_REPEAT each wall still shows the whole texture.
+ * Vertices 10-13: roof corners
+ */
+std::vector<float> unitBuildingVertices(bool is3D = true);
+
+/**
+ * @brief Place the unit building box for one building
+ * 
+ * @param building Building structure containing position and dimensions
+ * @param world Extent of the world the building belongs to
+ * @param is3D Coordinate system of the mesh the instance is drawn with
+ * @return BuildingInstance Offset, scale and material of the building
  */
-std::vector<float> buildingToVertices(const Building& building, 
-                                      int screenWidth, 
-                                      int screenHeight, 
-                                      bool is3D = true);
+BuildingInstance buildingToInstance(const Building& building, 
+                                    const WorldExtent& world, 
+                                    bool is3D = true);
 
 #endif // BUILDING_MESH_H
@@ -13,23 +13,22 @@
 
 #include <vector>
 #include "utils/algorithms.h" // For Point struct
+#include "core/city_config.h"  // For WorldExtent
 
 /**
  * @brief Convert 2D points to OpenGL vertices
  * 
- * Converts a series of 2D pixel coordinates to normalized device coordinates (-1 to 1)
- * for use with OpenGL. Filters out points outside the screen boundaries.
+ * Converts a series of 2D world coordinates to normalized device coordinates (-1 to 1)
+ * for use with OpenGL. Filters out points outside the world margins.
  * 
- * @param points Vector of 2D points in pixel coordinates
- * @param screenWidth Width of the viewport in pixels
- * @param screenHeight Height of the viewport in pixels
+ * @param points Vector of 2D points in world coordinates
+ * @param world Extent of the world the points belong to
  * @return std::vector<float> Vertex data in format (x, y, z) where z=0 for 2D elements
  * 
  * Each vertex has 3 floats: (x, y, 0.0)
- * Points outside the screen margins are filtered out
+ * Points outside the world margins are filtered out
  */
 std::vector<float> pointsToVertices(const std::vector<Point>& points, 
-                                     int screenWidth, 
-                                     int screenHeight);
+                                     const WorldExtent& world);
 
 #endif // MESH_UTILS_H
@@ -13,7 +13,8 @@
 #define PARK_MESH_H
 
 #include <vector>
-#include "utils/algorithms.h" // For Point struct
+#include "utils/algorithms.h" // For Circle struct
+#include "core/city_config.h"  // For WorldExtent
 
 /**
  * @brief Generate 3D mesh for a park (filled circle)
@@ -21,9 +22,8 @@
  * Creates a circular filled mesh using a triangle fan approach.
  * The mesh represents a grass-covered park area.
  * 
- * @param parkPoints Points defining the circular boundary of the park
- * @param screenWidth Width of the viewport in pixels
- * @param screenHeight Height of the viewport in pixels
+ * @param park Analytic circle (center and radius in world units) of the park
+ * @param world Extent of the world the park belongs to
  * @param is3D If true, uses 3D coordinate system (Y is up); if false, uses 2D system (Z is up)
  * @return std::vector<float> Vertex data with positions and UV coordinates (x, y, z, u, v)
  * 
@@ -34,9 +34,8 @@
  * Each vertex has 5 floats: (x, y, z, u, v)
  * Creates 32 triangles forming a filled circle
  */
-std::vector<float> parkTo3DMesh(const std::vector<Point>& parkPoints, 
-                                 int screenWidth, 
-                                 int screenHeight, 
+std::vector<float> parkTo3DMesh(const Circle& park, 
+                                 const WorldExtent& world, 
                                  bool is3D);
 
 /**
@@ -45,9 +44,8 @@ std::vector<float> parkTo3DMesh(const std::vector<Point>& parkPoints,
  * Similar to parkTo3DMesh but slightly raised above the ground plane
  * to make it visually distinct from parks.
  * 
- * @param fountainPoints Points defining the circular boundary of the fountain
- * @param screenWidth Width of the viewport in pixels
- * @param screenHeight Height of the viewport in pixels
+ * @param fountain Analytic circle (center and radius in world units) of the fountain
+ * @param world Extent of the world the fountain belongs to
  * @param is3D If true, uses 3D coordinate system (Y is up); if false, uses 2D system (Z is up)
  * @return std::vector<float> Vertex data with positions and UV coordinates (x, y, z, u, v)
  * 
@@ -56,9 +54,8 @@ std::vector<float> parkTo3DMesh(const std::vector<Point>& parkPoints,
  * - Parks: 0.006f
  * - Fountains: 0.008f
  */
-std::vector<float> fountainTo3DMesh(const std::vector<Point>& fountainPoints, 
-                                     int screenWidth, 
-                                     int screenHeight, 
+std::vector<float> fountainTo3DMesh(const Circle& fountain, 
+                                     const WorldExtent& world, 
                                      bool is3D);
 
 #endif // PARK_MESH_H
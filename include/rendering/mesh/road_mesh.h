@@ -2,8 +2,9 @@
  * @file road_mesh.h
  * @brief Road 3D Mesh Generation
  * 
- * Generates 3D road meshes from line segments with proper UV coordinates for texturing.
- * Supports both 2D and 3D view modes with appropriate coordinate systems.
+ * Generates 3D road meshes from road segments with proper UV coordinates for texturing,
+ * and the flat lines drawn in the 2D view. Both are built from the road's
+ * segment.
  * 
  * @author City Designer Team
  * @date November 2025
@@ -13,18 +14,19 @@
 #define ROAD_MESH_H
 
 #include <vector>
+#include <cstddef>
 #include "generation/road_generator.h" // For Road struct
-#include "utils/algorithms.h" // For Point struct
+#include "generation/road_graph.h"     // For junctions
 
 /**
- * @brief Generate 3D mesh for a road from points
+ * @brief Generate 3D mesh for a road segment
  * 
- * Creates a textured 3D mesh representing a road surface from a series of points.
- * The road is rendered as a strip of connected quads (2 triangles each).
+ * Creates a textured 3D mesh representing a road surface directly from the
+ * road's clipped centre line. The road is rendered as a single quad
+ * (2 triangles), clipped to the world margins.
  * 
- * @param road Road structure containing points defining the road path
- * @param screenWidth Width of the viewport in pixels
- * @param screenHeight Height of the viewport in pixels
+ * @param road Road structure containing the segment endpoints and width
+ * @param world Extent of the world the road belongs to
  * @param is3D If true, uses 3D coordinate system (Y is up); if false, uses 2D system (Z is up)
  * @return std::vector<float> Vertex data with positions and UV coordinates (x, y, z, u, v)
  * 
@@ -33,11 +35,106 @@
  * - 2D mode: X=left/right, Y=depth, Z=height
  * 
  * Each vertex has 5 floats: (x, y, z, u, v)
- * Each road segment produces 6 vertices (2 triangles)
+ * Each road produces 6 vertices (2 triangles), or none if it lies outside the margins
  */
 std::vector<float> roadTo3DMesh(const Road& road, 
-                                 int screenWidth, 
-                                 int screenHeight, 
+                                 const WorldExtent& world, 
                                  bool is3D);
 
+/**
+ * @brief Generate the 3D mesh of a whole road network, joined at junctions
+ * 
+ * Where roads meet, separate quads would overlap and z-fight at the same
+ * height. Instead every graph edge becomes a strip cut back to where it
+ * meets its neighbours, and every junction gets one patch polygon filling
+ * the space between the cut ends. Two roads meeting at an angle get a
+ * mitered join on the inside of the bend and a bevel on the outside, and
+ * a road crossing another is split around the patch. At sharp or shallow
+ * angles, where the miter corner would lie far down both roads or leave
+ * part of one uncovered, the two strips instead run on to the junction
+ * point and overlap. Wherever strips and patches overlap (such joins,
+ * junctions closer together than a road is wide, roads running side by
+ * side) the narrower ones are cut around the wider, so each point of the
+ * road surface is covered once and every point of the plain road quads
+ * is covered (see measureRoadCoverage()). Triangles without area are
+ * dropped. Edges repeated between the same two junctions are meshed once.
+ * 
+ * @param roads Roads of the network
+ * @param graph Graph built from exactly these roads (RoadGraph::build())
+ * @param world Extent of the world the roads belong to
+ * @param is3D If true, uses 3D coordinate system (Y is up); if false, uses 2D system (Z is up)
+ * @return std::vector<float> Triangles in the same vertex format as roadTo3DMesh()
+ * 
+ * Junctions outside the margins are not patched; strips are clipped there
+ * like single roads are.
+ */
+std::vector<float> roadNetworkTo3DMesh(const std::vector<Road>& roads, 
+                                       const RoadGraph& graph,
+                                       const WorldExtent& world, 
+                                       bool is3D);
+
+/**
+ * @brief How a joined road mesh covers the plain road quads
+ * 
+ * Counted on a grid of sample points over the view square.
+ */
+struct RoadCoverage {
+    size_t covered;     // Samples under at least one plain road quad
+    size_t holes;       // Of those, samples no joined triangle covers
+    size_t overdrawn;   // Samples more than one joined triangle covers
+    size_t zeroArea;    // Joined triangles without area
+};
+
+/**
+ * @brief Compare a joined road mesh with the union of the plain road quads
+ * 
+ * Joining must not leave any of a road uncovered, nor cover a point
+ * twice. Each sample of a samples x samples grid over the view square is
+ * tested against the roadTo3DMesh() quads of every road and against the
+ * triangles of the joined mesh. Samples on an edge two triangles share
+ * count for one of them only.
+ * 
+ * @param roads Roads the mesh was built from
+ * @param vertices Triangles from roadNetworkTo3DMesh()
+ * @param world Extent of the world the roads belong to
+ * @param is3D Coordinate system the mesh was built in
+ * @param samples Grid samples along each side of the view square
+ * @return RoadCoverage Sample and triangle counts
+ */
+RoadCoverage measureRoadCoverage(const std::vector<Road>& roads,
+                                 const std::vector<float>& vertices,
+                                 const WorldExtent& world,
+                                 bool is3D, int samples);
+
+/**
+ * @brief Check the joins that are easiest to get wrong
+ * 
+ * Meshes small networks with a sharp V join, a shallow crossing and a
+ * wide road bending sharply into a narrow one, and measures each with
+ * measureRoadCoverage(). Prints one line per network.
+ * 
+ * @return true if no network has holes, overdraw or zero-area triangles
+ */
+bool checkRoadJoins();
+
+/**
+ * @brief Generate the 2D line of a road segment
+ * 
+ * The kept interval of the road, clipped to the world margins, as one quad
+ * (2 triangles) two framebuffer pixels wide, with square ends. Core profile
+ * contexts only draw GL_LINES one pixel wide, so wide lines are meshed
+ * instead. The quad has to be rebuilt when the framebuffer is resized.
+ * 
+ * @param road Road structure containing the segment endpoints
+ * @param world Extent of the world the road belongs to
+ * @param framebufferWidth Width of the framebuffer the view fills, in pixels (> 0)
+ * @param framebufferHeight Height of the framebuffer the view fills, in pixels (> 0)
+ * @return std::vector<float> Vertex data in format (x, y, 0.0)
+ * 
+ * Each road produces 6 vertices, or none if it lies outside the margins
+ */
+std::vector<float> roadToLineMesh(const Road& road, 
+                                  const WorldExtent& world,
+                                  int framebufferWidth, int framebufferHeight);
+
 #endif // ROAD_MESH_H
@@ -36,6 +36,9 @@ private:
     GLint projectionLocation;
     GLint useTextureLocation;
     GLint is2DLocation;
+    GLint instancedLocation;
+    GLint materialTexLocation;
+    GLint materialColorLocation;
     
 public:
     /**
@@ -82,6 +85,8 @@ public:
     void setProjection(const float* projectionMatrix) const;
     void setUseTexture(bool use) const;
     void setIs2D(bool is2D) const;
+    void setInstanced(bool instanced) const;
+    void setMaterialColors(const float* colors) const;  ///< 3 RGB colours, one per material
     
     // Get uniform locations (for advanced usage)
     GLint getColorLocation() const { return colorLocation; }
@@ -89,6 +94,7 @@ public:
     GLint getProjectionLocation() const { return projectionLocation; }
     GLint getUseTextureLocation() const { return useTextureLocation; }
     GLint getIs2DLocation() const { return is2DLocation; }
+    GLint getInstancedLocation() const { return instancedLocation; }
     
 private:
     /**
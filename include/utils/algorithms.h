@@ -15,6 +15,7 @@
 
 #include <vector>
 #include <cmath>
+#include <map>
 
 /**
  * @struct Point
@@ -36,6 +37,81 @@ struct Point {
     Point(int x = 0, int y = 0) : x(x), y(y) {}
 };
 
+/**
+ * @struct PixelSpan
+ * @brief A run of consecutive pixels along one row or one column
+ * 
+ * Storing a run as start + length is far smaller than one Point per
+ * pixel. A filled disc is one horizontal run per row (midpointDiscSpans()).
+ */
+struct PixelSpan {
+    int x;          ///< X of the first pixel of the run
+    int y;          ///< Y of the first pixel of the run
+    int length;     ///< Number of pixels in the run (at least 1)
+    bool vertical;  ///< true: run walks along Y (fixed X); false: along X (fixed Y)
+    int step;       ///< +1 or -1, direction the run walks along its axis
+    
+    /**
+     * @brief Construct a new PixelSpan
+     * @param x X of the first pixel
+     * @param y Y of the first pixel
+     * @param length Number of pixels
+     * @param vertical Whether the run walks along Y
+     * @param step Direction of the walk (+1 or -1)
+     */
+    PixelSpan(int x = 0, int y = 0, int length = 1, bool vertical = false, int step = 1)
+        : x(x), y(y), length(length), vertical(vertical), step(step) {}
+    
+    /**
+     * @brief Get the i-th pixel of the run
+     * @param i Index in [0, length)
+     * @return Pixel coordinate
+     */
+    Point at(int i) const {
+        return vertical ? Point(x, y + i * step) : Point(x + i * step, y);
+    }
+};
+
+/**
+ * @struct Circle
+ * @brief Analytic circle used for parks and fountains
+ * 
+ * Stores the exact center and radius so collision and meshing code can
+ * work in O(1) per circle. The pixel perimeter needed by the 2D point
+ * renderer is rasterized with the Midpoint Circle Algorithm on first use
+ * and cached.
+ */
+struct Circle {
+    int centerX;    ///< X coordinate of circle center
+    int centerY;    ///< Y coordinate of circle center
+    int radius;     ///< Radius in pixels (0 = no circle)
+    
+    /**
+     * @brief Construct a new Circle
+     * @param cx X coordinate of center (default: 0)
+     * @param cy Y coordinate of center (default: 0)
+     * @param r Radius in pixels (default: 0)
+     */
+    Circle(int cx = 0, int cy = 0, int r = 0)
+        : centerX(cx), centerY(cy), radius(r), rasterized(false) {}
+    
+    /**
+     * @brief Check whether this record holds an actual circle
+     * @return true if the radius is zero or negative
+     */
+    bool empty() const { return radius <= 0; }
+    
+    /**
+     * @brief Get the rasterized perimeter, computing it on first call
+     * @return Perimeter points from midpointCircleOrdered()
+     */
+    const std::vector<Point>& perimeter() const;
+    
+private:
+    mutable std::vector<Point> perimeterPoints;  ///< Lazily rasterized perimeter
+    mutable bool rasterized;                     ///< Whether perimeterPoints is valid
+};
+
 /**
  * @brief Bresenham's Line Algorithm
  * 
@@ -49,10 +125,9 @@ struct Point {
  * @param y1 Ending Y coordinate
  * @return std::vector<Point> Ordered list of points forming the line
  * 
- * **Used for**:
- * - Road segments (Grid, Radial, Random patterns)
- * - Grid lines in layout
- * - Building outlines
+ * Roads are kept and drawn as segments, so the generator no longer walks
+ * their pixels; placement stamps roads into the occupancy raster as
+ * capsules (OccupancyGrid::stampThickSegment()).
  * 
  * **Time Complexity**: O(max(dx, dy)) where dx, dy are coordinate differences
  * **Space Complexity**: O(max(dx, dy)) for result vector
@@ -88,4 +163,68 @@ std::vector<Point> bresenhamLine(int x0, int y0, int x1, int y1);
  */
 std::vector<Point> midpointCircle(int centerX, int centerY, int radius);
 
+/**
+ * @brief Midpoint circle perimeter in angular order
+ * 
+ * Same pixels as midpointCircle(), but each pixel appears once and the
+ * list walks around the circle, clockwise on screen starting from the
+ * rightmost point. Consecutive entries are neighbouring pixels, so the
+ * list can be sampled at a fixed stride to get an even polygon.
+ * 
+ * @param centerX X coordinate of circle center
+ * @param centerY Y coordinate of circle center
+ * @param radius Radius of circle in pixels
+ * @return std::vector<Point> Deduplicated perimeter in angular order
+ * 
+ * **Time Complexity**: O(radius log radius)
+ * 
+ * @note Circle::perimeter() keeps the result for each circle, so a park is
+ * only rasterized once however often it is drawn
+ */
+std::vector<Point> midpointCircleOrdered(int centerX, int centerY, int radius);
+
+/**
+ * @brief Horizontal fill spans of a solid midpoint disc
+ * 
+ * One span per row from the top of the disc to the bottom. Each span runs
+ * between the outermost perimeter pixels of midpointCircle() in that row,
+ * so the fill and the outline always agree.
+ * 
+ * @param centerX X coordinate of circle center
+ * @param centerY Y coordinate of circle center
+ * @param radius Radius of circle in pixels
+ * @return std::vector<PixelSpan> 2 * radius + 1 horizontal spans, top row first
+ * 
+ * **Time Complexity**: O(radius)
+ */
+std::vector<PixelSpan> midpointDiscSpans(int centerX, int centerY, int radius);
+
+/**
+ * @class CirclePatternCache
+ * @brief Disc spans built once per radius and translated for each circle
+ * 
+ * Every park of a city has the same radius, so their disc spans differ
+ * only by a translation. The owner clears the cache between cities, which
+ * bounds it to the handful of radii one city uses.
+ */
+class CirclePatternCache {
+public:
+    /**
+     * @brief Get the midpointDiscSpans() of a circle from its radius pattern
+     * @param centerX X coordinate of circle center
+     * @param centerY Y coordinate of circle center
+     * @param radius Radius of circle in pixels
+     * @param spans Output: replaced by the translated spans, capacity is reused
+     */
+    void discSpans(int centerX, int centerY, int radius, std::vector<PixelSpan>& spans);
+    
+    /**
+     * @brief Drop every cached pattern
+     */
+    void clear() { discs.clear(); }
+    
+private:
+    std::map<int, std::vector<PixelSpan>> discs;  ///< Spans around the origin, by radius
+};
+
 #endif // ALGORITHMS_H
@@ -0,0 +1,49 @@
+/**
+ * @file delaunay.h
+ * @brief Delaunay Triangulation of Point Sets
+ *
+ * Sweep-hull triangulation in the style of Delaunator: points are added
+ * in order of distance from a seed triangle, each one is joined to the
+ * visible part of the convex hull, and edges are flipped until every
+ * triangle satisfies the empty-circumcircle condition.
+ *
+ * @author City Designer Team
+ * @date November 2025
+ */
+
+#ifndef DELAUNAY_H
+#define DELAUNAY_H
+
+#include <utility>
+#include <vector>
+#include "utils/algorithms.h" // For Point struct
+
+/**
+ * @brief Delaunay triangulation of a point set
+ *
+ * @param points Input points; duplicates are skipped
+ * @return std::vector<int> Triangles as consecutive index triples into points
+ *
+ * Returns no triangles when all points are collinear.
+ *
+ * **Time Complexity**: O(n log n) expected
+ * **Space Complexity**: O(n)
+ * @see https://github.com/mapbox/delaunator
+ */
+std::vector<int> delaunayTriangulate(const std::vector<Point>& points);
+
+/**
+ * @brief Unique undirected edges of the Delaunay triangulation
+ *
+ * The Delaunay graph is planar, connected and contains both the Euclidean
+ * minimum spanning tree and the relative neighborhood graph, which makes it
+ * a good starting point for sparse networks.
+ *
+ * @param points Input points
+ * @return std::vector<std::pair<int, int>> Index pairs with first < second
+ *
+ * For collinear input the points are chained in order along the line.
+ */
+std::vector<std::pair<int, int>> delaunayEdges(const std::vector<Point>& points);
+
+#endif // DELAUNAY_H
@@ -0,0 +1,103 @@
+/**
+ * @file geometry.h
+ * @brief Analytic 2D Geometry Helpers
+ *
+ * Constant-time tests between line segments and simple shapes. These
+ * operate on the vector form of city elements (road segments, building
+ * boxes) so generation code does not need to rasterize them first.
+ *
+ * @author City Designer Team
+ * @date November 2025
+ */
+
+#ifndef GEOMETRY_H
+#define GEOMETRY_H
+
+/**
+ * @brief Clip a segment against an axis-aligned box (Liang-Barsky)
+ *
+ * Computes the parameter interval of the segment P(t) = P0 + t * (P1 - P0)
+ * that lies inside the box. The interval is intersected with the incoming
+ * [tMin, tMax] range, so callers can clip an already-clipped segment.
+ *
+ * @param x0 Segment start X
+ * @param y0 Segment start Y
+ * @param x1 Segment end X
+ * @param y1 Segment end Y
+ * @param minX Box left edge
+ * @param minY Box top edge
+ * @param maxX Box right edge
+ * @param maxY Box bottom edge
+ * @param tMin In: lower bound of the range to clip. Out: clipped lower bound
+ * @param tMax In: upper bound of the range to clip. Out: clipped upper bound
+ * @return true if any part of the range lies inside the box
+ *
+ * **Time Complexity**: O(1)
+ * @see https://en.wikipedia.org/wiki/Liang%E2%80%93Barsky_algorithm
+ */
+bool clipSegmentToBox(float x0, float y0, float x1, float y1,
+                      float minX, float minY, float maxX, float maxY,
+                      float& tMin, float& tMax);
+
+/**
+ * @brief Check whether a segment touches an axis-aligned box
+ * @return true if any point of the segment lies inside or on the box
+ *
+ * Convenience wrapper around clipSegmentToBox() for the full [0, 1] range.
+ */
+bool segmentIntersectsBox(float x0, float y0, float x1, float y1,
+                          float minX, float minY, float maxX, float maxY);
+
+/**
+ * @brief Squared Euclidean distance between a segment and an axis-aligned box
+ *
+ * Returns 0 if the segment touches the box. Otherwise the closest pair of
+ * points involves either a segment endpoint or a box corner, so the result
+ * is the minimum over those eight point-to-shape distances.
+ *
+ * @return Squared distance in the same units as the inputs
+ *
+ * **Time Complexity**: O(1)
+ */
+float segmentBoxDistanceSquared(float x0, float y0, float x1, float y1,
+                                float minX, float minY, float maxX, float maxY);
+
+/**
+ * @brief Check whether a thick segment (capsule) overlaps an axis-aligned box
+ *
+ * A road of width w is the set of points within w/2 of its centre line,
+ * so this is the exact road-versus-footprint collision test.
+ *
+ * @param halfWidth Half of the segment thickness (plus any clearance)
+ * @return true if some point of the box is closer than halfWidth to the segment
+ */
+bool thickSegmentOverlapsBox(float x0, float y0, float x1, float y1, float halfWidth,
+                             float minX, float minY, float maxX, float maxY);
+
+/**
+ * @brief Intersect a line with a circle
+ *
+ * Solves |P0 + t * (P1 - P0) - C|^2 = r^2 for the parameter range where
+ * the infinite line through P0 and P1 lies inside the circle.
+ *
+ * @param x0 Line start X
+ * @param y0 Line start Y
+ * @param x1 Line end X
+ * @param y1 Line end Y
+ * @param cx Circle center X
+ * @param cy Circle center Y
+ * @param radius Circle radius
+ * @param tEnter Out: parameter where the line enters the circle
+ * @param tExit Out: parameter where the line leaves the circle
+ * @return true if the line crosses the circle (tEnter < tExit)
+ *
+ * The returned range is not clamped to [0, 1]; callers intersect it with
+ * the part of the line they care about.
+ *
+ * **Time Complexity**: O(1)
+ */
+bool lineCircleInterval(float x0, float y0, float x1, float y1,
+                        float cx, float cy, float radius,
+                        float& tEnter, float& tExit);
+
+#endif // GEOMETRY_H
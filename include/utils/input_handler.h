@@ -5,7 +5,7 @@
 #include "core/city_config.h"
 
 // Forward declaration
-class CityGenerator;
+class GenerationWorker;
 
 // Input Handler Class
 // Manages keyboard input and updates city configuration
@@ -13,13 +13,13 @@ class InputHandler {
 private:
     CityConfig& config;
     bool keysPressed[GLFW_KEY_LAST];  // Track key states to prevent repeated actions
-    CityGenerator* cityGen;  // Pointer to city generator
+    GenerationWorker* generationWorker;  // Runs generation requests in the background
     
 public:
     InputHandler(CityConfig& cfg);
     
-    // Set the city generator (for triggering generation)
-    void setCityGenerator(CityGenerator* gen) { cityGen = gen; }
+    // Set the generation worker (for triggering generation)
+    void setGenerationWorker(GenerationWorker* worker) { generationWorker = worker; }
     
     // Process keyboard input
     void processInput(GLFWwindow* window);
@@ -27,15 +27,9 @@ public:
     // Display help/controls
     static void displayControls();
     
-    // Check if generation was requested
-    bool generationRequested() const { return genRequested; }
-    void clearGenerationRequest() { genRequested = false; }
-    
 private:
     // Helper to check if key was just pressed (not held)
     bool isKeyJustPressed(GLFWwindow* window, int key);
-    
-    bool genRequested;  // Flag for generation request
 };
 
 #endif // INPUT_HANDLER_H
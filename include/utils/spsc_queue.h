@@ -0,0 +1,84 @@
+/**
+ * @file spsc_queue.h
+ * @brief Lock-Free Single-Producer/Single-Consumer Queue
+ *
+ * Fixed-capacity ring buffer for handing work from one thread to exactly
+ * one other. Each side only ever writes its own index, so pushing and
+ * popping need no locks and never wait on the other thread.
+ *
+ * @author City Designer Team
+ * @date November 2025
+ */
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @class SpscQueue
+ * @brief Bounded lock-free queue for one producer thread and one consumer thread
+ *
+ * Indices count up forever and are wrapped with a mask, so a full queue
+ * (tail - head == Capacity) can be told apart from an empty one without
+ * wasting a slot. The producer publishes a filled slot with a release
+ * store of the tail, which the consumer's acquire load pairs with; the
+ * head works the same way in the other direction.
+ *
+ * @tparam T Element type; moved in and out of the slots
+ * @tparam Capacity Number of slots, a power of two
+ */
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscQueue capacity must be a power of two");
+
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * @brief Append an element (producer thread only)
+     * @param item Element to move into the queue; left untouched on failure
+     * @return false if the queue is full
+     */
+    bool tryPush(T&& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        slots[t & (Capacity - 1)] = std::move(item);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest element (consumer thread only)
+     * @param out Receives the element
+     * @return false if the queue is empty
+     */
+    bool tryPop(T& out) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        out = std::move(slots[h & (Capacity - 1)]);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::array<T, Capacity> slots;
+
+    // On separate cache lines so the two threads do not invalidate each
+    // other's index on every operation
+    alignas(64) std::atomic<size_t> head;   ///< Next slot to pop (written by the consumer)
+    alignas(64) std::atomic<size_t> tail;   ///< Next slot to push (written by the producer)
+};
+
+#endif // SPSC_QUEUE_H
@@ -130,3 +130,14 @@ void Application::update() {
     glfwSwapBuffers(window);
     glfwPollEvents();
 }
+
+// Get framebuffer size
+void Application::getFramebufferSize(int& fbWidth, int& fbHeight) const {
+    glfwGetFramebufferSize(window, &fbWidth, &fbHeight);
+}
+
+// Set window title
+void Application::setTitle(const std::string& newTitle) {
+    title = newTitle;
+    glfwSetWindowTitle(window, title.c_str());
+}
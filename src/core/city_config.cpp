@@ -5,6 +5,9 @@ void CityConfig::printConfig() const {
     std::cout << "\n╔════════════════════════════════════════╗\n";
     std::cout << "║      CITY DESIGNER CONFIGURATION       ║\n";
     std::cout << "╠════════════════════════════════════════╣\n";
+    std::string worldSize = std::to_string(static_cast<int>(world.width)) + "x" + std::to_string(static_cast<int>(world.height));
+    std::cout << "║ Scale:          " << getScaleTierString() << std::string(23 - getScaleTierString().length(), ' ') << "║\n";
+    std::cout << "║ World Size:     " << worldSize << " units" << std::string(17 - worldSize.length(), ' ') << "║\n";
     std::cout << "║ Buildings:      " << numBuildings << " buildings" << std::string(18 - std::to_string(numBuildings).length(), ' ') << "║\n";
     std::cout << "║ Layout Size:    " << layoutSize << "x" << layoutSize << " grid" << std::string(17 - 2*std::to_string(layoutSize).length(), ' ') << "║\n";
     std::cout << "║ Road Pattern:   " << getRoadPatternString() << std::string(23 - getRoadPatternString().length(), ' ') << "║\n";
@@ -17,6 +20,9 @@ void CityConfig::printConfig() const {
     if (useStandardSize) {
         std::cout << "║   (Width/Depth: " << static_cast<int>(standardWidth) << "x" << static_cast<int>(standardDepth) << " px)" << std::string(17 - std::to_string(static_cast<int>(standardWidth)).length() - std::to_string(static_cast<int>(standardDepth)).length(), ' ') << "║\n";
     }
+    std::cout << "║ Placement:      " << getPlacementModeString() << std::string(23 - getPlacementModeString().length(), ' ') << "║\n";
+    std::cout << "║ Collision:      " << getCollisionBackendString() << std::string(23 - getCollisionBackendString().length(), ' ') << "║\n";
+    std::cout << "║ Seed:           " << seed << std::string(23 - std::to_string(seed).length(), ' ') << "║\n";
     std::cout << "║ View Mode:      " << (view3D ? "3D View" : "2D View") << std::string(23 - (view3D ? 7 : 7), ' ') << "║\n";
     std::cout << "╚════════════════════════════════════════╝\n\n";
 }
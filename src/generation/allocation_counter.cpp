@@ -0,0 +1,102 @@
+#include "generation/generation_profiler.h"
+#include <cstdlib>
+#include <new>
+
+// Heap byte counts for generation profiles come from replacing the global
+// allocation functions, which changes them for the whole program. That only
+// happens in builds made with COUNT_ALLOCATIONS defined
+// (COUNT_ALLOCATIONS=1 ./build.sh); other builds count nothing.
+#ifdef COUNT_ALLOCATIONS
+
+// Running total of bytes requested from operator new on each thread. A plain
+// thread-local needs no locking and no dynamic initialization, so counting
+// every allocation in the program costs one add.
+static thread_local uint64_t allocatedOnThread = 0;
+
+static void* countedAlloc(std::size_t size) {
+    allocatedOnThread += size;
+    return std::malloc(size ? size : 1);
+}
+
+static void* countedAlignedAlloc(std::size_t size, std::align_val_t alignment) {
+    allocatedOnThread += size;
+    // posix_memalign needs at least pointer alignment
+    std::size_t align = static_cast<std::size_t>(alignment);
+    if (align < sizeof(void*)) align = sizeof(void*);
+    void* memory = nullptr;
+    if (posix_memalign(&memory, align, size ? size : 1) != 0) return nullptr;
+    return memory;
+}
+
+// Every replaceable form is defined here, so no allocation bypasses the
+// count and no memory is released by a deallocation function that did not
+// come from the same allocator
+void* operator new(std::size_t size) {
+    if (void* memory = countedAlloc(size)) return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (void* memory = countedAlloc(size)) return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAlloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAlloc(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* memory = countedAlignedAlloc(size, alignment)) return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    if (void* memory = countedAlignedAlloc(size, alignment)) return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return countedAlignedAlloc(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return countedAlignedAlloc(size, alignment);
+}
+
+// malloc and posix_memalign memory are both released with free
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { std::free(memory); }
+
+bool allocationsCounted() {
+    return true;
+}
+
+uint64_t threadAllocatedBytes() {
+    return allocatedOnThread;
+}
+
+#else
+
+bool allocationsCounted() {
+    return false;
+}
+
+uint64_t threadAllocatedBytes() {
+    return 0;
+}
+
+#endif // COUNT_ALLOCATIONS
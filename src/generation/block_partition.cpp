@@ -0,0 +1,409 @@
+#include "generation/block_partition.h"
+#include "generation/road_graph.h"
+#include "utils/geometry.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+// Points closer than this along a connector ray are the same node
+static const float CONNECT_SNAP = 1e-3f;
+
+namespace {
+
+struct PlanarEdge {
+    int a, b;
+    float clearance;
+};
+
+// Doubly connected view of a planar graph: outgoing half-edges of every
+// node in counter-clockwise order
+struct PlanarGraph {
+    std::vector<float> xs, ys;
+    std::vector<PlanarEdge> edges;
+
+    int addNode(float x, float y) {
+        xs.push_back(x);
+        ys.push_back(y);
+        return static_cast<int>(xs.size()) - 1;
+    }
+};
+
+// Join every road network that does not reach the city bounds to the one
+// that does, with a zero-clearance edge running left from its leftmost
+// node to the first edge it meets. The graph becomes connected, so every
+// face has a single boundary cycle and no face hides an island.
+void connectIslands(PlanarGraph& graph, const RoadGraph& roadGraph, int boundsNode) {
+    int components = roadGraph.componentCount();
+    int mainland = roadGraph.componentOf(boundsNode);
+
+    std::vector<int> leftmost(components, -1);
+    for (size_t n = 0; n < graph.xs.size(); n++) {
+        int c = roadGraph.componentOf(static_cast<int>(n));
+        int& best = leftmost[c];
+        if (best < 0 || graph.xs[n] < graph.xs[best] ||
+            (graph.xs[n] == graph.xs[best] && graph.ys[n] < graph.ys[best])) {
+            best = static_cast<int>(n);
+        }
+    }
+
+    // Left to right, so each ray can land on islands already joined
+    std::vector<int> islands;
+    for (int c = 0; c < components; c++) {
+        if (c != mainland && leftmost[c] >= 0) islands.push_back(leftmost[c]);
+    }
+    std::sort(islands.begin(), islands.end(),
+              [&](int a, int b) { return graph.xs[a] < graph.xs[b]; });
+
+    for (int node : islands) {
+        float px = graph.xs[node];
+        float py = graph.ys[node];
+
+        int hitEdge = -1;
+        float hitX = 0.0f;
+        for (size_t e = 0; e < graph.edges.size(); e++) {
+            const PlanarEdge& edge = graph.edges[e];
+            float ax = graph.xs[edge.a], ay = graph.ys[edge.a];
+            float bx = graph.xs[edge.b], by = graph.ys[edge.b];
+            if (std::min(ay, by) > py || std::max(ay, by) < py) continue;
+
+            float x = (ay == by) ? std::max(ax, bx) : ax + (py - ay) * (bx - ax) / (by - ay);
+            if (x >= px - CONNECT_SNAP) continue;
+            if (hitEdge < 0 || x > hitX) {
+                hitEdge = static_cast<int>(e);
+                hitX = x;
+            }
+        }
+        if (hitEdge < 0) continue;  // Entirely left of the bounds
+
+        // Land on an existing node, or split the edge that was hit
+        PlanarEdge& hit = graph.edges[hitEdge];
+        int target;
+        if (std::fabs(graph.xs[hit.a] - hitX) <= CONNECT_SNAP && std::fabs(graph.ys[hit.a] - py) <= CONNECT_SNAP) {
+            target = hit.a;
+        } else if (std::fabs(graph.xs[hit.b] - hitX) <= CONNECT_SNAP && std::fabs(graph.ys[hit.b] - py) <= CONNECT_SNAP) {
+            target = hit.b;
+        } else {
+            target = graph.addNode(hitX, py);
+            PlanarEdge rest = { target, hit.b, hit.clearance };
+            hit.b = target;
+            graph.edges.push_back(rest);
+        }
+        graph.edges.push_back({ target, node, 0.0f });
+    }
+}
+
+// Distance test for one block edge against a cell. Edges with clearance
+// only block cells they actually pass through, so lots may share them.
+bool edgeBlocksCell(const CityBlock& block, int e, float minX, float minY, float maxX, float maxY) {
+    size_t next = (static_cast<size_t>(e) + 1) % block.xs.size();
+    float x0 = block.xs[e], y0 = block.ys[e];
+    float x1 = block.xs[next], y1 = block.ys[next];
+    float clearance = block.clearance[e];
+
+    if (clearance > 0.0f) {
+        return segmentBoxDistanceSquared(x0, y0, x1, y1, minX, minY, maxX, maxY) < clearance * clearance;
+    }
+
+    float tMin = 0.0f, tMax = 1.0f;
+    if (!clipSegmentToBox(x0, y0, x1, y1, minX, minY, maxX, maxY, tMin, tMax)) return false;
+    float t = 0.5f * (tMin + tMax);
+    float mx = x0 + (x1 - x0) * t;
+    float my = y0 + (y1 - y0) * t;
+    return mx > minX && mx < maxX && my > minY && my < maxY;
+}
+
+bool circleBlocksCell(const KeepOutCircle& circle, float minX, float minY, float maxX, float maxY) {
+    float grow = circle.boxGrowth;
+    float dx = circle.x - std::min(std::max(circle.x, minX - grow), maxX + grow);
+    float dy = circle.y - std::min(std::max(circle.y, minY - grow), maxY + grow);
+    return dx * dx + dy * dy < circle.radius * circle.radius;
+}
+
+// Even-odd test against the block polygon
+bool blockContains(const CityBlock& block, float x, float y) {
+    bool inside = false;
+    size_t count = block.xs.size();
+    for (size_t i = 0, j = count - 1; i < count; j = i++) {
+        float yi = block.ys[i], yj = block.ys[j];
+        if ((yi > y) == (yj > y)) continue;
+        float crossX = block.xs[i] + (y - yi) * (block.xs[j] - block.xs[i]) / (yj - yi);
+        if (x < crossX) inside = !inside;
+    }
+    return inside;
+}
+
+// Recursive lot cutter for one block
+struct LotCutter {
+    const CityBlock& block;
+    int blockIndex;
+    const std::vector<KeepOutCircle>& keepOut;
+    float lotWidth, lotDepth;
+    float minWidth, minDepth;
+    std::vector<Lot>& lots;
+
+    // Share a clear side out evenly among as many whole lots as fit;
+    // cells still near obstacles are cut on the lot lattice from their start
+    static float splitAt(float start, float size, float lot, bool clear) {
+        int fit = static_cast<int>(size / lot);
+        if (fit < 2) return start + 0.5f * size;
+        return start + (fit / 2) * (clear ? size / fit : lot);
+    }
+
+    // Extent of the area an obstacle keeps lots out of
+    void reachOf(int e, float& x0, float& y0, float& x1, float& y1) const {
+        size_t next = (static_cast<size_t>(e) + 1) % block.xs.size();
+        float clearance = block.clearance[e];
+        x0 = std::min(block.xs[e], block.xs[next]) - clearance;
+        x1 = std::max(block.xs[e], block.xs[next]) + clearance;
+        y0 = std::min(block.ys[e], block.ys[next]) - clearance;
+        y1 = std::max(block.ys[e], block.ys[next]) + clearance;
+    }
+
+    // Pick a cut along the edge of some obstacle's reach, preferring the
+    // obstacle that runs across most of the cell, such as a road through
+    // it. Cutting there lands neighbouring cells exactly on the clearance
+    // line, which keeps lots flush with straight roads. Obstacles covering
+    // less than half the cell are left to the regular splits.
+    bool findCut(float minX, float minY, float maxX, float maxY,
+                 const std::vector<int>& edges, const std::vector<int>& circles,
+                 bool& alongX, float& split) const {
+        float bestCover = 0.5f;
+        float bestOffCentre = 0.0f;
+        bool found = false;
+        auto consider = [&](bool axisX, float lo, float hi, float acrossLo, float acrossHi) {
+            float start = axisX ? minX : minY;
+            float end = axisX ? maxX : maxY;
+            float acrossStart = axisX ? minY : minX;
+            float acrossEnd = axisX ? maxY : maxX;
+            float cover = (std::min(acrossHi, acrossEnd) - std::max(acrossLo, acrossStart)) /
+                          (acrossEnd - acrossStart);
+            if (cover < bestCover) return;
+
+            for (float at : { lo, hi }) {
+                if (at <= start || at >= end) continue;
+                float offCentre = std::fabs(at - 0.5f * (start + end)) / (end - start);
+                if (found && cover == bestCover && offCentre >= bestOffCentre) continue;
+                found = true;
+                bestCover = cover;
+                bestOffCentre = offCentre;
+                alongX = axisX;
+                split = at;
+            }
+        };
+
+        for (int e : edges) {
+            float x0, y0, x1, y1;
+            reachOf(e, x0, y0, x1, y1);
+            consider(true, x0, x1, y0, y1);
+            consider(false, y0, y1, x0, x1);
+        }
+        for (int c : circles) {
+            const KeepOutCircle& circle = keepOut[c];
+            float reach = circle.radius + circle.boxGrowth;
+            float x0 = circle.x - reach, x1 = circle.x + reach;
+            float y0 = circle.y - reach, y1 = circle.y + reach;
+            consider(true, x0, x1, y0, y1);
+            consider(false, y0, y1, x0, x1);
+        }
+        return found;
+    }
+
+    // inside: 1 or 0 once known for a clear cell, -1 while edges remain
+    void cut(float minX, float minY, float maxX, float maxY,
+             const std::vector<int>& edges, const std::vector<int>& circles, int inside) {
+        float width = maxX - minX;
+        float depth = maxY - minY;
+        if (width < minWidth || depth < minDepth) return;
+
+        bool clear = edges.empty() && circles.empty();
+        bool alongX;
+        float split;
+        if (clear) {
+            if (inside < 0) inside = blockContains(block, 0.5f * (minX + maxX), 0.5f * (minY + maxY)) ? 1 : 0;
+            if (!inside) return;
+
+            bool splitX = width >= 2.0f * lotWidth;
+            bool splitY = depth >= 2.0f * lotDepth;
+            if (!splitX && !splitY) {
+                lots.emplace_back(minX, minY, maxX, maxY, blockIndex);
+                return;
+            }
+
+            // Cut across the side that is longest relative to the lot size
+            alongX = splitX && (!splitY || width / lotWidth >= depth / lotDepth);
+            split = alongX ? splitAt(minX, width, lotWidth, true) : splitAt(minY, depth, lotDepth, true);
+        } else if (!findCut(minX, minY, maxX, maxY, edges, circles, alongX, split)) {
+            bool splitX = width >= 2.0f * minWidth;
+            bool splitY = depth >= 2.0f * minDepth;
+            if (!splitX && !splitY) return;
+
+            alongX = splitX && (!splitY || width / lotWidth >= depth / lotDepth);
+            split = alongX ? splitAt(minX, width, lotWidth, false) : splitAt(minY, depth, lotDepth, false);
+        }
+
+        for (int half = 0; half < 2; half++) {
+            float x0 = minX, y0 = minY, x1 = maxX, y1 = maxY;
+            if (alongX) (half == 0 ? x1 : x0) = split;
+            else (half == 0 ? y1 : y0) = split;
+
+            std::vector<int> childEdges;
+            for (int e : edges) {
+                if (edgeBlocksCell(block, e, x0, y0, x1, y1)) childEdges.push_back(e);
+            }
+            std::vector<int> childCircles;
+            for (int c : circles) {
+                if (circleBlocksCell(keepOut[c], x0, y0, x1, y1)) childCircles.push_back(c);
+            }
+            cut(x0, y0, x1, y1, childEdges, childCircles, inside);
+        }
+    }
+};
+
+} // namespace
+
+BlockPartition::BlockPartition()
+    : boundsMinX(0.0f), boundsMinY(0.0f), boundsMaxX(0.0f), boundsMaxY(0.0f) {
+}
+
+void BlockPartition::build(const std::vector<Road>& roads, const std::vector<float>& roadClearance,
+                           int minX, int minY, int maxX, int maxY) {
+    blocks.clear();
+    boundsMinX = static_cast<float>(minX);
+    boundsMinY = static_cast<float>(minY);
+    boundsMaxX = static_cast<float>(maxX);
+    boundsMaxY = static_cast<float>(maxY);
+    if (maxX <= minX || maxY <= minY) return;
+
+    // The bounds take part as four zero-width roads closing the network
+    std::vector<Road> network = roads;
+    network.emplace_back(Point(minX, minY), Point(maxX, minY), 0);
+    network.emplace_back(Point(maxX, minY), Point(maxX, maxY), 0);
+    network.emplace_back(Point(maxX, maxY), Point(minX, maxY), 0);
+    network.emplace_back(Point(minX, maxY), Point(minX, minY), 0);
+
+    RoadGraph roadGraph;
+    roadGraph.build(network);
+
+    PlanarGraph graph;
+    for (const auto& node : roadGraph.getNodes()) graph.addNode(node.x, node.y);
+    for (const auto& edge : roadGraph.getEdges()) {
+        float clearance = edge.road < static_cast<int>(roads.size()) ? roadClearance[edge.road] : 0.0f;
+        graph.edges.push_back({ edge.from, edge.to, clearance });
+    }
+    connectIslands(graph, roadGraph, roadGraph.nearestNode(boundsMinX, boundsMinY));
+
+    // Outgoing half-edges around each node in counter-clockwise order.
+    // Half-edge 2e runs a -> b along edge e, 2e + 1 runs b -> a.
+    size_t nodeCount = graph.xs.size();
+    size_t halfCount = graph.edges.size() * 2;
+    auto origin = [&](size_t h) { const PlanarEdge& e = graph.edges[h / 2]; return (h & 1) ? e.b : e.a; };
+    auto target = [&](size_t h) { const PlanarEdge& e = graph.edges[h / 2]; return (h & 1) ? e.a : e.b; };
+
+    std::vector<int> firstOut(nodeCount + 1, 0);
+    for (size_t h = 0; h < halfCount; h++) firstOut[origin(h) + 1]++;
+    std::partial_sum(firstOut.begin(), firstOut.end(), firstOut.begin());
+
+    std::vector<int> outgoing(halfCount);
+    std::vector<float> angle(halfCount);
+    {
+        std::vector<int> fill(firstOut.begin(), firstOut.end() - 1);
+        for (size_t h = 0; h < halfCount; h++) {
+            int a = origin(h), b = target(h);
+            angle[h] = std::atan2(graph.ys[b] - graph.ys[a], graph.xs[b] - graph.xs[a]);
+            outgoing[fill[a]++] = static_cast<int>(h);
+        }
+    }
+    std::vector<int> slot(halfCount);
+    for (size_t n = 0; n < nodeCount; n++) {
+        auto begin = outgoing.begin() + firstOut[n];
+        auto end = outgoing.begin() + firstOut[n + 1];
+        std::sort(begin, end, [&](int a, int b) { return angle[a] < angle[b]; });
+        for (int i = firstOut[n]; i < firstOut[n + 1]; i++) slot[outgoing[i]] = i;
+    }
+
+    // Walk faces: after arriving at a node, leave by the next half-edge
+    // clockwise from the one just travelled back along
+    std::vector<bool> visited(halfCount, false);
+    std::vector<CityBlock> faces;
+    int outerFace = -1;
+    float outerArea = 0.0f;
+    for (size_t start = 0; start < halfCount; start++) {
+        if (visited[start]) continue;
+
+        CityBlock face;
+        double area = 0.0;
+        size_t h = start;
+        do {
+            visited[h] = true;
+            int a = origin(h), b = target(h);
+            face.xs.push_back(graph.xs[a]);
+            face.ys.push_back(graph.ys[a]);
+            face.clearance.push_back(graph.edges[h / 2].clearance);
+            area += static_cast<double>(graph.xs[a]) * graph.ys[b] -
+                    static_cast<double>(graph.xs[b]) * graph.ys[a];
+
+            size_t back = h ^ 1;
+            int first = firstOut[b], count = firstOut[b + 1] - first;
+            h = outgoing[first + (slot[back] - first + count - 1) % count];
+        } while (h != start);
+
+        face.area = static_cast<float>(0.5 * area);
+        if (outerFace < 0 || std::fabs(face.area) > std::fabs(outerArea)) {
+            outerFace = static_cast<int>(faces.size());
+            outerArea = face.area;
+        }
+        faces.push_back(std::move(face));
+    }
+
+    // The outer face winds the other way from every bounded face
+    for (size_t f = 0; f < faces.size(); f++) {
+        CityBlock& face = faces[f];
+        if (static_cast<int>(f) == outerFace || face.area == 0.0f) continue;
+        if ((face.area > 0.0f) == (outerArea > 0.0f)) continue;
+
+        auto xs = std::minmax_element(face.xs.begin(), face.xs.end());
+        auto ys = std::minmax_element(face.ys.begin(), face.ys.end());
+        face.minX = std::max(*xs.first, boundsMinX);
+        face.maxX = std::min(*xs.second, boundsMaxX);
+        face.minY = std::max(*ys.first, boundsMinY);
+        face.maxY = std::min(*ys.second, boundsMaxY);
+        if (face.minX >= face.maxX || face.minY >= face.maxY) continue;  // Outside the bounds
+
+        face.area = std::fabs(face.area);
+        blocks.push_back(std::move(face));
+    }
+}
+
+float BlockPartition::totalArea() const {
+    float total = 0.0f;
+    for (const auto& block : blocks) total += block.area;
+    return total;
+}
+
+std::vector<Lot> BlockPartition::subdivide(float lotWidth, float lotDepth, float minWidth, float minDepth,
+                                           const std::vector<KeepOutCircle>& keepOut) const {
+    std::vector<Lot> lots;
+    if (lotWidth <= 0.0f || lotDepth <= 0.0f) return lots;
+    minWidth = std::min(std::max(minWidth, 1.0f), lotWidth);
+    minDepth = std::min(std::max(minDepth, 1.0f), lotDepth);
+
+    for (size_t b = 0; b < blocks.size(); b++) {
+        const CityBlock& block = blocks[b];
+        LotCutter cutter = { block, static_cast<int>(b), keepOut, lotWidth, lotDepth, minWidth, minDepth, lots };
+
+        std::vector<int> edges;
+        for (size_t e = 0; e < block.xs.size(); e++) {
+            if (edgeBlocksCell(block, static_cast<int>(e), block.minX, block.minY, block.maxX, block.maxY)) {
+                edges.push_back(static_cast<int>(e));
+            }
+        }
+        std::vector<int> circles;
+        for (size_t c = 0; c < keepOut.size(); c++) {
+            if (circleBlocksCell(keepOut[c], block.minX, block.minY, block.maxX, block.maxY)) {
+                circles.push_back(static_cast<int>(c));
+            }
+        }
+        cutter.cut(block.minX, block.minY, block.maxX, block.maxY, edges, circles, -1);
+    }
+    return lots;
+}
@@ -0,0 +1,234 @@
+#include "generation/city_cache.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+// File layout: magic, format version, key, then each element list as a
+// count followed by fixed-size records. Values are written in native byte
+// order; the cache is local to the machine that produced it.
+static const char CACHE_MAGIC[4] = { 'C', 'I', 'T', 'Y' };
+static const uint32_t CACHE_VERSION = 5;
+
+// FNV-1a over raw bytes
+static void hashBytes(uint64_t& hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+}
+
+template <typename T>
+static void hashValue(uint64_t& hash, const T& value) {
+    hashBytes(hash, &value, sizeof(value));
+}
+
+template <typename T>
+static void writeValue(std::ofstream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+static bool readValue(std::ifstream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+static void writeCircle(std::ofstream& out, const Circle& circle) {
+    writeValue<int32_t>(out, circle.centerX);
+    writeValue<int32_t>(out, circle.centerY);
+    writeValue<int32_t>(out, circle.radius);
+}
+
+static bool readCircle(std::ifstream& in, Circle& circle) {
+    int32_t cx, cy, r;
+    if (!readValue(in, cx) || !readValue(in, cy) || !readValue(in, r)) return false;
+    circle = Circle(cx, cy, r);
+    return true;
+}
+
+CityCache::CityCache(const std::string& dir, size_t capacity)
+    : directory(dir), memoryCapacity(capacity) {
+}
+
+uint64_t CityCache::keyFor(const CityConfig& config) {
+    uint64_t hash = 14695981039346656037ULL;
+    hashValue(hash, CACHE_VERSION);
+    hashValue(hash, config.world.width);
+    hashValue(hash, config.world.height);
+    hashValue(hash, config.world.margin);
+    hashValue(hash, config.seed);
+    hashValue(hash, config.numBuildings);
+    hashValue(hash, config.layoutSize);
+    hashValue(hash, static_cast<int>(config.roadPattern));
+    hashValue(hash, config.roadWidth);
+    hashValue(hash, static_cast<int>(config.skylineType));
+    hashValue(hash, config.parkRadius);
+    hashValue(hash, config.numParks);
+    hashValue(hash, config.fountainRadius);
+    hashValue(hash, config.useStandardSize);
+    hashValue(hash, config.standardWidth);
+    hashValue(hash, config.standardDepth);
+    hashValue(hash, static_cast<int>(config.placementMode));
+    hashValue(hash, static_cast<int>(config.collisionBackend));
+    return hash;
+}
+
+bool CityCache::lookup(uint64_t key, CityData& out) {
+    auto it = memory.find(key);
+    if (it != memory.end()) {
+        out = it->second;
+        return true;
+    }
+
+    if (readFile(key, out)) {
+        remember(key, out);
+        return true;
+    }
+    return false;
+}
+
+void CityCache::store(uint64_t key, const CityData& city) {
+    remember(key, city);
+    if (!writeFile(key, city)) {
+        std::cerr << "Warning: could not write city cache file " << pathFor(key) << "\n";
+    }
+}
+
+std::string CityCache::pathFor(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.city", static_cast<unsigned long long>(key));
+    return directory + "/" + name;
+}
+
+void CityCache::remember(uint64_t key, const CityData& city) {
+    if (memoryCapacity == 0) return;
+
+    if (memory.find(key) == memory.end()) {
+        if (memory.size() >= memoryCapacity) {
+            memory.erase(insertionOrder.front());
+            insertionOrder.pop_front();
+        }
+        insertionOrder.push_back(key);
+    }
+    memory[key] = city;
+}
+
+bool CityCache::readFile(uint64_t key, CityData& out) const {
+    std::ifstream in(pathFor(key), std::ios::binary);
+    if (!in) return false;
+
+    char magic[4];
+    uint32_t version;
+    uint64_t storedKey;
+    if (!in.read(magic, sizeof(magic)) || !readValue(in, version) || !readValue(in, storedKey)) {
+        return false;
+    }
+    if (!std::equal(magic, magic + 4, CACHE_MAGIC) || version != CACHE_VERSION || storedKey != key) {
+        return false;  // Foreign, outdated or colliding file: treat as a miss
+    }
+
+    CityData city;
+    uint32_t count;
+
+    if (!readValue(in, city.world.width) || !readValue(in, city.world.height) ||
+        !readValue(in, city.world.margin)) {
+        return false;
+    }
+
+    if (!readValue(in, count)) return false;
+    city.roads.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        int32_t sx, sy, ex, ey, width;
+        float tStart, tEnd;
+        if (!readValue(in, sx) || !readValue(in, sy) || !readValue(in, ex) || !readValue(in, ey) ||
+            !readValue(in, tStart) || !readValue(in, tEnd) || !readValue(in, width)) {
+            return false;
+        }
+        city.roads.emplace_back(Point(sx, sy), Point(ex, ey), width, tStart, tEnd);
+    }
+
+    if (!readValue(in, count)) return false;
+    city.parks.resize(count);
+    for (auto& park : city.parks) {
+        if (!readCircle(in, park)) return false;
+    }
+
+    if (!readCircle(in, city.fountain)) return false;
+
+    if (!readValue(in, count)) return false;
+    city.buildings.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        float x, y, width, depth, height;
+        int32_t type;
+        if (!readValue(in, x) || !readValue(in, y) || !readValue(in, width) ||
+            !readValue(in, depth) || !readValue(in, height) || !readValue(in, type)) {
+            return false;
+        }
+        city.buildings.emplace_back(x, y, width, depth, height, static_cast<BuildingType>(type));
+    }
+
+    // The road graph is derived data and cheap to rebuild, so it is not stored
+    city.roadGraph.build(city.roads);
+    
+    city.isGenerated = true;
+    out = city;
+    return true;
+}
+
+bool CityCache::writeFile(uint64_t key, const CityData& city) const {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) return false;
+
+    // Write to a temporary file and rename it into place, so an interrupted
+    // write never leaves a truncated file under the real name
+    std::string path = pathFor(key);
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+
+        out.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        writeValue(out, CACHE_VERSION);
+        writeValue(out, key);
+
+        writeValue(out, city.world.width);
+        writeValue(out, city.world.height);
+        writeValue(out, city.world.margin);
+
+        writeValue<uint32_t>(out, city.roads.size());
+        for (const auto& road : city.roads) {
+            writeValue<int32_t>(out, road.start.x);
+            writeValue<int32_t>(out, road.start.y);
+            writeValue<int32_t>(out, road.end.x);
+            writeValue<int32_t>(out, road.end.y);
+            writeValue(out, road.tStart);
+            writeValue(out, road.tEnd);
+            writeValue<int32_t>(out, road.width);
+        }
+
+        writeValue<uint32_t>(out, city.parks.size());
+        for (const auto& park : city.parks) {
+            writeCircle(out, park);
+        }
+
+        writeCircle(out, city.fountain);
+
+        writeValue<uint32_t>(out, city.buildings.size());
+        for (const auto& building : city.buildings) {
+            writeValue(out, building.x);
+            writeValue(out, building.y);
+            writeValue(out, building.width);
+            writeValue(out, building.depth);
+            writeValue(out, building.height);
+            writeValue<int32_t>(out, building.type);
+        }
+
+        if (!out) return false;
+    }
+
+    std::filesystem::rename(tempPath, path, error);
+    return !error;
+}
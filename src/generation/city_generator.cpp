@@ -1,29 +1,255 @@
 #include "generation/city_generator.h"
+#include "generation/block_partition.h"
+#include "utils/geometry.h"
 #include <iostream>
 #include <random>
 #include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
-CityGenerator::CityGenerator(int width, int height) 
-    : roadGen(width, height), screenWidth(width), screenHeight(height) {
+// Smallest cell size of the obstacle grid in pixels. Cells are roughly one
+// building plus its buffer (see obstacleCellSize()), so a placement query
+// touches only a handful of cells.
+static const float OBSTACLE_CELL_SIZE = 64.0f;
+
+// Minimum clearances around each kind of obstacle, in pixels
+static const float BUILDING_BUFFER = 25.0f;   // Between buildings
+static const float PARK_BUFFER = 35.0f;       // Around parks
+static const float FOUNTAIN_BUFFER = 35.0f;   // Around the fountain
+static const float ROAD_BUFFER = 5.0f;        // Around road edges
+static const float EDGE_CLEARANCE = 10.0f;    // Beyond the world margin
+
+// Midpoint discs are centred on a pixel, analytic circles on a pixel
+// corner. A disc this many pixels wider than the circle covers every pixel
+// the circle touches.
+static const int DISC_PATTERN_SLACK = 2;
+
+// Largest occupancy raster the RASTER backend will allocate (128 MB of bits).
+// Bigger worlds fall back to the GEOMETRIC backend.
+static const double MAX_RASTER_PIXELS = 1024.0 * 1024.0 * 1024.0;
+
+// Each stage draws from its own stream derived from the config seed, so a
+// change in how many numbers one stage consumes cannot shift the others
+enum class RandomStream : uint32_t {
+    PARKS = 1,
+    ROADS = 2,
+    BUILDINGS = 3,
+    HEIGHTS = 4
+};
+
+static uint32_t streamSeed(uint32_t seed, RandomStream stream) {
+    std::seed_seq sequence{ seed, static_cast<uint32_t>(stream) };
+    uint32_t derived;
+    sequence.generate(&derived, &derived + 1);
+    return derived;
 }
 
-void CityGenerator::generateCity(const CityConfig& config) {
+// Footprint range for buildings when useStandardSize is off
+static const float MIN_RANDOM_BUILDING_SIZE = 20.0f;
+static const float MAX_RANDOM_BUILDING_SIZE = 60.0f;
+
+// Obstacle grid cell size for a config. Standard buildings grow with the
+// world of the scale tier, and the cells grow with them.
+static float obstacleCellSize(const CityConfig& config) {
+    float size = config.useStandardSize
+        ? std::max(config.standardWidth, config.standardDepth)
+        : MAX_RANDOM_BUILDING_SIZE;
+    return std::max(OBSTACLE_CELL_SIZE, size + BUILDING_BUFFER);
+}
+
+// PARALLEL_TILES placement aims for about this many tiles: enough jobs per
+// phase to keep many cores busy, few enough that per-tile setup stays cheap.
+// The tiling must not depend on the core count, or results would too.
+static const float TARGET_TILE_COUNT = 256.0f;
+
+// BLOCK_LOTS placement centres each building in its lot with at least this
+// much land on every side, so buildings in neighbouring lots are always
+// more than BUILDING_BUFFER apart
+static const float LOT_INSET = BUILDING_BUFFER / 2.0f + 0.5f;
+
+// Elements per stream batch: small enough for the first buildings to show
+// up almost at once, large enough to keep queue traffic low
+static const size_t STREAM_BATCH_SIZE = 256;
+
+// Rough share of generation time spent in each stage, for progress reports
+static const float STAGE_WEIGHTS[] = {
+    0.05f,  // PARKS
+    0.10f,  // ROAD_LAYOUT
+    0.10f,  // ROAD_CLIPPING
+    0.70f,  // PLACEMENT
+    0.05f   // HEIGHTS
+};
+
+CityGenerator::CityGenerator() 
+    : maxRoadHalfWidth(0.0f), collisionBackend(CollisionBackend::GEOMETRIC),
+      worldWidth(0), worldHeight(0), edgeMargin(0.0f), unit(1.0f), progressStride(5), buildingTarget(0),
+      lastChanges(0), cancelFlag(nullptr), progress(0.0f), stream(nullptr), streamedBuildings(0),
+      previewHeights(false), previewSkyline(SkylineType::MIXED) {
+}
+
+bool CityGenerator::generateCity(const CityConfig& config, const std::atomic<bool>* cancel) {
+    cancelFlag = cancel;
+    progress.store(0.0f, std::memory_order_relaxed);
+    profile.begin(config);
+    ProfileScope timer(profile, ProfileSection::GENERATE_CITY);
+    
+    uint64_t key = CityCache::keyFor(config);
+    bool cached;
+    {
+        ProfileScope lookupTimer(profile, ProfileSection::CACHE_LOOKUP);
+        cached = cache.lookup(key, cityData);
+    }
+    if (cached) {
+        profile.cacheHit = true;
+        std::cout << "\n♻️  Loaded cached city (seed " << config.seed << ")\n";
+        std::cout << "   - Total parks: " << cityData.parks.size() << "\n";
+        std::cout << "   - Total buildings: " << cityData.buildings.size() << "\n";
+        std::cout << "   - Total roads: " << cityData.roads.size() << "\n\n" << std::flush;
+        
+        // Generation is deterministic, so the stages that would have rerun
+        // are exactly the ones whose output differs from the previous city.
+        // Cached cities are finished cities; the road layout they were cut
+        // from is not stored, so it is regenerated if clipping has to rerun.
+        lastChanges = pipeline.changedStages(config);
+        pipeline.reset(config, ALL_STAGES & ~stageBit(GenerationStage::ROAD_LAYOUT));
+        roadLayout.clear();
+        cancelFlag = nullptr;
+        
+        if (stream) {
+            if (lastChanges & stageBit(GenerationStage::PARKS)) {
+                streamParks();
+            }
+            if (lastChanges & stageBit(GenerationStage::ROAD_CLIPPING)) {
+                streamRoads();
+            }
+            if (lastChanges & (stageBit(GenerationStage::PLACEMENT) | stageBit(GenerationStage::HEIGHTS))) {
+                beginBuildingStream(config, true);
+                streamNewBuildings();
+            }
+            ProfileScope flushTimer(profile, ProfileSection::STREAM_FLUSH);
+            stream->flush();
+        }
+        progress.store(1.0f, std::memory_order_relaxed);
+        return true;
+    }
+    
+    bool finished = buildCity(config);
+    cancelFlag = nullptr;
+    
+    // Even a cancelled run leaves the stream in step with this generator:
+    // whatever it cut short is sent again when those stages rerun
+    if (stream) {
+        ProfileScope flushTimer(profile, ProfileSection::STREAM_FLUSH);
+        stream->flush();
+    }
+    if (!finished) {
+        profile.cancelled = true;
+        return false;
+    }
+    
+    {
+        ProfileScope storeTimer(profile, ProfileSection::CACHE_STORE);
+        cache.store(key, cityData);
+    }
+    progress.store(1.0f, std::memory_order_relaxed);
+    return true;
+}
+
+bool CityGenerator::buildCity(const CityConfig& config) {
+    StageMask run = pipeline.stagesToRun(config);
+    StageMask changed = pipeline.changedStages(config);
+    StageMask done = 0;
+    auto runs = [&](GenerationStage stage) { return (run & stageBit(stage)) != 0; };
+    
+    // A stage is done once it ran to the end; one cut short by a cancel
+    // left partial output behind
+    auto finish = [&](GenerationStage stage) {
+        if (cancelled()) return false;
+        done |= stageBit(stage);
+        reportProgress(stage, 1.0f);
+        return true;
+    };
+    auto abandon = [&]() {
+        pipeline.markRan(done, config);
+        pipeline.markStale(run & ~done);
+        lastChanges = changed;
+        std::cout << "\n⏹️  City generation cancelled\n" << std::flush;
+        return false;
+    };
+    
     std::cout << "\n╔════════════════════════════════════════╗\n";
     std::cout << "║     🏗️  GENERATING CITY...  🏗️        ║\n";
     std::cout << "╚════════════════════════════════════════╝\n" << std::flush;
     
-    // Clear previous city data
-    cityData.clear();
+    cityData.world = config.world;
+    cityData.isGenerated = false;
+    worldWidth = static_cast<int>(config.world.width);
+    worldHeight = static_cast<int>(config.world.height);
+    edgeMargin = config.world.margin + EDGE_CLEARANCE;
+    unit = config.worldUnit();
     
-    // GENERATION ORDER:
+    // GENERATION ORDER (stages whose inputs are unchanged are skipped):
     // 1. Generate parks and fountains first (using Midpoint Circle Algorithm)
-    generateParks(config);
+    if (runs(GenerationStage::PARKS)) {
+        generateParks(config);
+        if (stream) streamParks();
+        if (!finish(GenerationStage::PARKS)) return abandon();
+    } else {
+        std::cout << "\n🌳 Parks unchanged (" << cityData.parks.size() << " parks)\n";
+        reportProgress(GenerationStage::PARKS, 1.0f);
+    }
     
-    // 2. Generate roads (using Bresenham's Line Algorithm) - avoid parks/fountains
-    cityData.roads = roadGen.generateRoadsAvoidingObstacles(config, cityData.parks, cityData.fountain);
+    // 2. Generate roads as line segments, then cut them
+    //    around parks and fountains
+    if (runs(GenerationStage::ROAD_LAYOUT)) {
+        ProfileScope layoutTimer(profile, ProfileSection::ROAD_LAYOUT);
+        roadGen.seed(streamSeed(config.seed, RandomStream::ROADS));
+        roadLayout = roadGen.generateRoads(config);
+        if (!finish(GenerationStage::ROAD_LAYOUT)) return abandon();
+    }
+    reportProgress(GenerationStage::ROAD_LAYOUT, 1.0f);
+    if (runs(GenerationStage::ROAD_CLIPPING)) {
+        {
+            ProfileScope clipTimer(profile, ProfileSection::ROAD_CLIPPING);
+            cityData.roads = roadGen.clipRoads(roadLayout, config.worldRoadWidth(), cityData.parks, cityData.fountain);
+        }
+        buildRoadGraph();
+        if (stream) streamRoads();
+        if (!finish(GenerationStage::ROAD_CLIPPING)) return abandon();
+    } else {
+        std::cout << "\n🛣️  Roads unchanged (" << cityData.roads.size() << " segments)\n";
+        reportProgress(GenerationStage::ROAD_CLIPPING, 1.0f);
+    }
     
     // 3. Generate buildings last (avoid parks, fountains, and roads)
-    generateBuildings(config);
+    if (runs(GenerationStage::PLACEMENT)) {
+        indexObstacles(config);
+        if (stream) beginBuildingStream(config, false);
+        generateBuildings(config);
+        profile.occupancyPixelsStamped = occupancy.getStampedPixels();
+        if (stream) streamNewBuildings();
+        if (!finish(GenerationStage::PLACEMENT)) return abandon();
+    } else {
+        std::cout << "\n🏢 Building footprints unchanged (" << cityData.buildings.size() << " buildings)\n";
+        reportProgress(GenerationStage::PLACEMENT, 1.0f);
+    }
+    
+    // 4. Give every building its height and type
+    if (runs(GenerationStage::HEIGHTS)) {
+        assignHeights(config);
+        
+        // Buildings placed in this run were streamed with these heights
+        // already; otherwise the new heights have to be sent
+        if (stream && !runs(GenerationStage::PLACEMENT)) {
+            beginBuildingStream(config, true);
+            streamNewBuildings();
+        }
+        if (!finish(GenerationStage::HEIGHTS)) return abandon();
+    }
+    
+    pipeline.markRan(run, config);
+    lastChanges = changed;
     
     // Mark as generated
     cityData.isGenerated = true;
@@ -32,9 +258,26 @@ void CityGenerator::generateCity(const CityConfig& config) {
     std::cout << "   - Total parks: " << cityData.parks.size() << "\n";
     std::cout << "   - Total buildings: " << cityData.buildings.size() << "\n";
     std::cout << "   - Total roads: " << cityData.roads.size() << "\n\n" << std::flush;
+    return true;
+}
+
+void CityGenerator::reportProgress(GenerationStage stage, float fraction) {
+    float before = 0.0f;
+    for (int s = 0; s < static_cast<int>(stage); s++) {
+        before += STAGE_WEIGHTS[s];
+    }
+    progress.store(before + STAGE_WEIGHTS[static_cast<int>(stage)] * fraction, std::memory_order_relaxed);
 }
 
 void CityGenerator::generateParks(const CityConfig& config) {
+    ProfileScope timer(profile, ProfileSection::PARKS);
+    cityData.parks.clear();
+    cityData.fountain = Circle();
+    
+    // The obstacle grid holds only parks while they are spaced out; the
+    // placement stage rebuilds it with everything buildings must avoid
+    obstacleGrid.reset(worldWidth, worldHeight, obstacleCellSize(config));
+    
     if (config.numParks == 0) {
         std::cout << "\n🌳 No parks requested\n";
         return;
@@ -42,11 +285,12 @@ void CityGenerator::generateParks(const CityConfig& config) {
     
     std::cout << "\n🌳 Generating " << config.numParks << " parks...\n";
     
+    // Radii in world units
+    int parkRadius = static_cast<int>(config.parkRadius * unit);
+    int fountainRadius = static_cast<int>(config.fountainRadius * unit);
+    
     // Random number generator for park placement
-    std::random_device rd;
-    std::mt19937 rng(rd());
-    std::uniform_int_distribution<int> xDist(100, screenWidth - 100);
-    std::uniform_int_distribution<int> yDist(100, screenHeight - 100);
+    std::mt19937 rng(streamSeed(config.seed, RandomStream::PARKS));
     
     int attempts = 0;
     int maxAttempts = config.numParks * 100; // More attempts for finding valid positions
@@ -55,10 +299,10 @@ void CityGenerator::generateParks(const CityConfig& config) {
         attempts++;
         
         // Random position for park with margins
-        int marginX = config.parkRadius + 50;
-        int marginY = config.parkRadius + 50;
-        std::uniform_int_distribution<int> xDistMargin(marginX, screenWidth - marginX);
-        std::uniform_int_distribution<int> yDistMargin(marginY, screenHeight - marginY);
+        int marginX = parkRadius + static_cast<int>(config.world.margin);
+        int marginY = parkRadius + static_cast<int>(config.world.margin);
+        std::uniform_int_distribution<int> xDistMargin(marginX, worldWidth - marginX);
+        std::uniform_int_distribution<int> yDistMargin(marginY, worldHeight - marginY);
         
         int x = xDistMargin(rng);
         int y = yDistMargin(rng);
@@ -66,19 +310,16 @@ void CityGenerator::generateParks(const CityConfig& config) {
         bool validPosition = true;
         
         // CHECK 1: Overlap with existing parks
-        const float minParkDistance = config.parkRadius * 2.5f; // Good spacing between parks
+        const float minParkDistance = parkRadius * 2.5f; // Good spacing between parks
         
-        for (const auto& existingPark : cityData.parks) {
-            if (existingPark.empty()) continue;
+        obstacleGrid.forEachInRange(x - minParkDistance, y - minParkDistance,
+                                    x + minParkDistance, y + minParkDistance,
+                                    [&](const GridEntry& entry) {
+            if (entry.kind != GridEntryKind::PARK) return true;
             
-            // Calculate center of existing park
-            float existingX = 0, existingY = 0;
-            for (const auto& point : existingPark) {
-                existingX += point.x;
-                existingY += point.y;
-            }
-            existingX /= existingPark.size();
-            existingY /= existingPark.size();
+            const Circle& existingPark = cityData.parks[entry.index];
+            float existingX = existingPark.centerX;
+            float existingY = existingPark.centerY;
             
             // Check center-to-center distance
             float dx = x - existingX;
@@ -87,18 +328,19 @@ void CityGenerator::generateParks(const CityConfig& config) {
             
             if (distance < minParkDistance) {
                 validPosition = false;
-                break;
+                return false;
             }
-        }
+            return true;
+        });
         
         // CHECK 2: Overlap with fountain (reserved center space)
-        if (validPosition && config.fountainRadius > 0) {
-            int centerX = screenWidth / 2;
-            int centerY = screenHeight / 2;
+        if (validPosition && fountainRadius > 0) {
+            int centerX = worldWidth / 2;
+            int centerY = worldHeight / 2;
             float dx = x - centerX;
             float dy = y - centerY;
             float distance = std::sqrt(dx * dx + dy * dy);
-            float minFountainDistance = config.parkRadius + config.fountainRadius + 30.0f;
+            float minFountainDistance = parkRadius + fountainRadius + 30.0f * unit;
             
             if (distance < minFountainDistance) {
                 validPosition = false;
@@ -106,12 +348,15 @@ void CityGenerator::generateParks(const CityConfig& config) {
         }
         
         if (validPosition) {
-            // Use Midpoint Circle Algorithm to generate park
-            std::vector<Point> park = midpointCircle(x, y, config.parkRadius);
-            cityData.parks.push_back(park);
+            // Store the park as an analytic circle; its Midpoint Circle
+            // perimeter is rasterized on demand for 2D rendering
+            cityData.parks.push_back(Circle(x, y, parkRadius));
+            obstacleGrid.insert(GridEntry(GridEntryKind::PARK, cityData.parks.size() - 1),
+                                x - parkRadius, y - parkRadius,
+                                x + parkRadius, y + parkRadius);
             
             std::cout << "   - Park " << (i + 1) << " at (" << x << ", " << y 
-                      << ") with radius " << config.parkRadius << "\n";
+                      << ") with radius " << parkRadius << "\n";
             i++; // Successfully placed a park
         }
     }
@@ -121,129 +366,225 @@ void CityGenerator::generateParks(const CityConfig& config) {
     }
     
     // Add a central fountain if requested (stored separately for different rendering color)
-    if (config.fountainRadius > 0) {
-        int centerX = screenWidth / 2;
-        int centerY = screenHeight / 2;
+    if (fountainRadius > 0) {
+        int centerX = worldWidth / 2;
+        int centerY = worldHeight / 2;
         
-        cityData.fountain = midpointCircle(centerX, centerY, config.fountainRadius);
+        cityData.fountain = Circle(centerX, centerY, fountainRadius);
         
         std::cout << "   - Central fountain at (" << centerX << ", " << centerY 
-                  << ") with radius " << config.fountainRadius << "\n";
+                  << ") with radius " << fountainRadius << "\n";
     }
 }
 
-void CityGenerator::generateBuildings(const CityConfig& config) {
-    if (config.numBuildings == 0) {
-        std::cout << "\n🏢 No buildings requested\n";
-        return;
+void CityGenerator::indexObstacles(const CityConfig& config) {
+    ProfileScope timer(profile, ProfileSection::OBSTACLE_INDEX);
+    obstacleGrid.reset(worldWidth, worldHeight, obstacleCellSize(config));
+    maxRoadHalfWidth = 0.0f;
+    
+    // The occupancy raster is only allocated when it will be used
+    collisionBackend = config.collisionBackend;
+    if (collisionBackend == CollisionBackend::RASTER &&
+        static_cast<double>(worldWidth) * worldHeight > MAX_RASTER_PIXELS) {
+        std::cout << "   ⚠️  World too large for the occupancy raster, using geometric collision\n";
+        collisionBackend = CollisionBackend::GEOMETRIC;
+    }
+    if (collisionBackend == CollisionBackend::RASTER) {
+        occupancy.reset(worldWidth, worldHeight);
+    } else {
+        occupancy.reset(0, 0);
     }
     
-    std::cout << "\n🏢 Generating " << config.numBuildings << " buildings...\n";
+    // Circles are stamped as midpoint discs grown by their buffer. Parks
+    // share one radius, so after the first park the spans are a cached
+    // pattern moved to each centre; the cache only lives for this city.
+    circlePatterns.clear();
+    std::vector<PixelSpan> discSpans;
+    auto stampCircle = [&](const Circle& circle, float buffer) {
+        int radius = static_cast<int>(std::ceil(circle.radius + buffer)) + DISC_PATTERN_SLACK;
+        circlePatterns.discSpans(circle.centerX, circle.centerY, radius, discSpans);
+        occupancy.stampSpans(discSpans.data(), discSpans.size(), static_cast<int>(std::ceil(buffer)));
+    };
     
-    // Random number generator
-    std::random_device rd;
-    std::mt19937 rng(rd());
+    for (size_t p = 0; p < cityData.parks.size(); p++) {
+        const Circle& park = cityData.parks[p];
+        obstacleGrid.insert(GridEntry(GridEntryKind::PARK, p),
+                            park.centerX - park.radius, park.centerY - park.radius,
+                            park.centerX + park.radius, park.centerY + park.radius);
+        if (collisionBackend == CollisionBackend::RASTER) {
+            stampCircle(park, PARK_BUFFER);
+        }
+    }
+    
+    const Circle& fountain = cityData.fountain;
+    if (!fountain.empty()) {
+        obstacleGrid.insert(GridEntry(GridEntryKind::FOUNTAIN, 0),
+                            fountain.centerX - fountain.radius, fountain.centerY - fountain.radius,
+                            fountain.centerX + fountain.radius, fountain.centerY + fountain.radius);
+        if (collisionBackend == CollisionBackend::RASTER) {
+            stampCircle(fountain, FOUNTAIN_BUFFER);
+        }
+    }
     
-    // Position distribution (avoid edges)
-    std::uniform_int_distribution<int> xDist(50, screenWidth - 50);
-    std::uniform_int_distribution<int> yDist(50, screenHeight - 50);
+    // Each road segment is bucketed into the cells along its thick centre line
+    for (size_t r = 0; r < cityData.roads.size(); r++) {
+        const Road& road = cityData.roads[r];
+        float halfWidth = road.width / 2.0f;
+        maxRoadHalfWidth = std::max(maxRoadHalfWidth, halfWidth);
+        
+        obstacleGrid.insertSegment(GridEntry(GridEntryKind::ROAD, r),
+                                   road.x0(), road.y0(), road.x1(), road.y1(), halfWidth);
+        if (collisionBackend == CollisionBackend::RASTER) {
+            occupancy.stampThickSegment(road.x0(), road.y0(), road.x1(), road.y1(),
+                                        halfWidth + ROAD_BUFFER);
+        }
+    }
+}
+
+void CityGenerator::buildRoadGraph() {
+    ProfileScope timer(profile, ProfileSection::ROAD_GRAPH);
+    cityData.roadGraph.build(cityData.roads);
     
-    // Building dimensions
-    std::uniform_real_distribution<float> widthDist(20.0f, 60.0f);
-    std::uniform_real_distribution<float> depthDist(20.0f, 60.0f);
+    const RoadGraph& graph = cityData.roadGraph;
+    std::cout << "   - Road graph: " << graph.getNodes().size() << " nodes, "
+              << graph.getEdges().size() << " edges, "
+              << graph.crossingCount() << " crossings, "
+              << graph.componentCount() << " connected networks\n";
+}
+
+// Check AABB collision with strict buffer
+// Buildings must have at least 'BUILDING_BUFFER' pixels between them
+static bool buildingsTooClose(float x, float y, float width, float depth, const Building& existing) {
+    float halfWidth = width / 2.0f;
+    float halfDepth = depth / 2.0f;
+    float existingHalfWidth = existing.width / 2.0f;
+    float existingHalfDepth = existing.depth / 2.0f;
     
+    return !(x + halfWidth + BUILDING_BUFFER < existing.x - existingHalfWidth ||
+             x - halfWidth - BUILDING_BUFFER > existing.x + existingHalfWidth ||
+             y + halfDepth + BUILDING_BUFFER < existing.y - existingHalfDepth ||
+             y - halfDepth - BUILDING_BUFFER > existing.y + existingHalfDepth);
+}
+
+// Use standard size or random size based on configuration
+static void rollBuildingSize(const CityConfig& config, std::mt19937& rng, float& width, float& depth) {
+    if (config.useStandardSize) {
+        width = config.standardWidth;
+        depth = config.standardDepth;
+    } else {
+        std::uniform_real_distribution<float> sizeDist(MIN_RANDOM_BUILDING_SIZE, MAX_RANDOM_BUILDING_SIZE);
+        width = sizeDist(rng);
+        depth = sizeDist(rng);
+    }
+}
+
+// Determine building type and height based on skyline configuration.
+// Heights are in district pixels times unit.
+static void rollBuildingHeight(SkylineType skylineType, float unit, std::mt19937& rng,
+                               BuildingType& type, float& height) {
     // Height distribution based on skyline type
-    std::uniform_real_distribution<float> lowRiseHeight(10.0f, 30.0f);
-    std::uniform_real_distribution<float> midRiseHeight(40.0f, 100.0f);
-    std::uniform_real_distribution<float> highRiseHeight(120.0f, 250.0f);
+    std::uniform_real_distribution<float> lowRiseHeight(10.0f * unit, 30.0f * unit);
+    std::uniform_real_distribution<float> midRiseHeight(40.0f * unit, 100.0f * unit);
+    std::uniform_real_distribution<float> highRiseHeight(120.0f * unit, 250.0f * unit);
     std::uniform_int_distribution<int> typeDist(0, 2);
     
-    int attempts = 0;
-    int maxAttempts = config.numBuildings * 50; // Increased attempts for stricter collision checks
-    
-    while (cityData.buildings.size() < (size_t)config.numBuildings && attempts < maxAttempts) {
-        attempts++;
-        
-        // Generate random position with better margins
-        std::uniform_int_distribution<int> xDistBetter(80, screenWidth - 80);
-        std::uniform_int_distribution<int> yDistBetter(80, screenHeight - 80);
-        
-        float x = xDistBetter(rng);
-        float y = yDistBetter(rng);
-        
-        // Use standard size or random size based on configuration
-        float width, depth;
-        if (config.useStandardSize) {
-            width = config.standardWidth;
-            depth = config.standardDepth;
-        } else {
-            width = widthDist(rng);
-            depth = depthDist(rng);
-        }
-        
-        // Check if position is valid (doesn't overlap roads/parks)
-        if (!isValidBuildingPosition(x, y, width, depth)) {
-            continue;
-        }
-        
-        // Determine building type and height based on skyline configuration
-        BuildingType type;
-        float height;
-        
-        switch (config.skylineType) {
-            case SkylineType::LOW_RISE:
-                // All low-rise buildings
-                type = BuildingType::LOW_RISE;
-                height = lowRiseHeight(rng);
-                break;
-                
-            case SkylineType::MID_RISE:
-                // All mid-rise buildings
-                type = BuildingType::MID_RISE;
-                height = midRiseHeight(rng);
-                break;
-                
-            case SkylineType::MIXED:
-                // Mix of all types
-                {
-                    int typeChoice = typeDist(rng);
-                    if (typeChoice == 0) {
-                        type = BuildingType::LOW_RISE;
-                        height = lowRiseHeight(rng);
-                    } else if (typeChoice == 1) {
-                        type = BuildingType::MID_RISE;
-                        height = midRiseHeight(rng);
-                    } else {
-                        type = BuildingType::HIGH_RISE;
-                        height = highRiseHeight(rng);
-                    }
+    switch (skylineType) {
+        case SkylineType::LOW_RISE:
+            // All low-rise buildings
+            type = BuildingType::LOW_RISE;
+            height = lowRiseHeight(rng);
+            break;
+            
+        case SkylineType::MID_RISE:
+            // All mid-rise buildings
+            type = BuildingType::MID_RISE;
+            height = midRiseHeight(rng);
+            break;
+            
+        case SkylineType::MIXED:
+            // Mix of all types
+            {
+                int typeChoice = typeDist(rng);
+                if (typeChoice == 0) {
+                    type = BuildingType::LOW_RISE;
+                    height = lowRiseHeight(rng);
+                } else if (typeChoice == 1) {
+                    type = BuildingType::MID_RISE;
+                    height = midRiseHeight(rng);
+                } else {
+                    type = BuildingType::HIGH_RISE;
+                    height = highRiseHeight(rng);
                 }
-                break;
-                
-            case SkylineType::SKYSCRAPER:
-                // Mostly high-rise with some mid-rise
-                {
-                    int typeChoice = typeDist(rng);
-                    if (typeChoice <= 1) {
-                        type = BuildingType::HIGH_RISE;
-                        height = highRiseHeight(rng);
-                    } else {
-                        type = BuildingType::MID_RISE;
-                        height = midRiseHeight(rng);
-                    }
+            }
+            break;
+            
+        case SkylineType::SKYSCRAPER:
+            // Mostly high-rise with some mid-rise
+            {
+                int typeChoice = typeDist(rng);
+                if (typeChoice <= 1) {
+                    type = BuildingType::HIGH_RISE;
+                    height = highRiseHeight(rng);
+                } else {
+                    type = BuildingType::MID_RISE;
+                    height = midRiseHeight(rng);
                 }
-                break;
-        }
-        
-        // Create and add building
-        cityData.buildings.emplace_back(x, y, width, depth, height, type);
-        
-        if (cityData.buildings.size() % 5 == 0) {
-            std::cout << "   - Generated " << cityData.buildings.size() << " buildings...\n" << std::flush;
-        }
+            }
+            break;
+    }
+}
+
+void CityGenerator::generateBuildings(const CityConfig& config) {
+    ProfileScope timer(profile, ProfileSection::PLACEMENT);
+    cityData.buildings.clear();
+    
+    if (config.numBuildings == 0) {
+        std::cout << "\n🏢 No buildings requested\n";
+        return;
+    }
+    
+    std::cout << "\n🏢 Generating " << config.numBuildings << " buildings ("
+              << config.getPlacementModeString() << " placement)...\n";
+    
+    // Report progress about twenty times however large the city is
+    progressStride = std::max<size_t>(5, config.numBuildings / 20);
+    buildingTarget = config.numBuildings;
+    
+    // Random number generator
+    std::mt19937 rng(streamSeed(config.seed, RandomStream::BUILDINGS));
+    
+    switch (config.placementMode) {
+        case PlacementMode::POISSON_DISK:
+            placeBuildingsPoissonDisk(config, rng);
+            break;
+        case PlacementMode::PARALLEL_TILES:
+            placeBuildingsTiled(config, streamSeed(config.seed, RandomStream::BUILDINGS));
+            break;
+        case PlacementMode::BLOCK_LOTS:
+            placeBuildingsInLots(config, rng);
+            break;
+        case PlacementMode::RANDOM:
+        default:
+            placeBuildingsRandom(config, rng);
+            break;
     }
+    if (cancelled()) return;
     
     std::cout << "   ✓ Completed " << cityData.buildings.size() << " buildings\n";
+}
+
+void CityGenerator::assignHeights(const CityConfig& config) {
+    ProfileScope timer(profile, ProfileSection::HEIGHTS);
+    if (cityData.buildings.empty()) return;
+    
+    // Heights come from their own stream, in building order, so a new
+    // skyline re-rolls them without moving a single footprint
+    std::mt19937 rng(streamSeed(config.seed, RandomStream::HEIGHTS));
+    for (auto& building : cityData.buildings) {
+        rollBuildingHeight(config.skylineType, unit, rng, building.type, building.height);
+    }
+    
+    std::cout << "\n🏙️  " << config.getSkylineTypeString() << " skyline\n";
     
     // Count by type
     int lowRise = 0, midRise = 0, highRise = 0;
@@ -258,151 +599,535 @@ void CityGenerator::generateBuildings(const CityConfig& config) {
     std::cout << "   - Low-rise: " << lowRise << " | Mid-rise: " << midRise << " | High-rise: " << highRise << "\n";
 }
 
-bool CityGenerator::isValidBuildingPosition(float x, float y, float width, float depth) const {
-    // Calculate building bounding box with generous margins
-    float halfWidth = width / 2.0f;
-    float halfDepth = depth / 2.0f;
-    const float buildingBuffer = 25.0f; // Increased buffer between buildings
+void CityGenerator::streamParks() {
+    CityBatch batch(CityBatchKind::PARKS, true, cityData.world);
+    batch.parks = cityData.parks;
+    batch.fountain = cityData.fountain;
+    stream->publish(std::move(batch));
+}
+
+void CityGenerator::streamRoads() {
+    // Always at least one batch, so an empty road set still replaces the old one
+    size_t sent = 0;
+    do {
+        size_t end = std::min(cityData.roads.size(), sent + STREAM_BATCH_SIZE);
+        CityBatch batch(CityBatchKind::ROADS, sent == 0, cityData.world);
+        batch.roads.assign(cityData.roads.begin() + sent, cityData.roads.begin() + end);
+        
+        // The renderer joins roads at junctions once it has them all
+        if (end == cityData.roads.size()) {
+            batch.lastRoads = true;
+            batch.roadGraph = cityData.roadGraph;
+        }
+        stream->publish(std::move(batch));
+        sent = end;
+    } while (sent < cityData.roads.size());
+}
+
+void CityGenerator::beginBuildingStream(const CityConfig& config, bool heightsAssigned) {
+    streamedBuildings = 0;
+    previewHeights = !heightsAssigned;
+    previewRng.seed(streamSeed(config.seed, RandomStream::HEIGHTS));
+    previewSkyline = config.skylineType;
+    stream->publish(CityBatch(CityBatchKind::BUILDINGS, true, cityData.world));
+}
+
+void CityGenerator::streamNewBuildings() {
+    while (streamedBuildings < cityData.buildings.size()) {
+        size_t end = std::min(cityData.buildings.size(), streamedBuildings + STREAM_BATCH_SIZE);
+        CityBatch batch(CityBatchKind::BUILDINGS, false, cityData.world);
+        batch.buildings.assign(cityData.buildings.begin() + streamedBuildings, cityData.buildings.begin() + end);
+        
+        // assignHeights() rolls in building order from the same stream, so
+        // rolling here in the same order gives the same heights
+        if (previewHeights) {
+            for (auto& building : batch.buildings) {
+                rollBuildingHeight(previewSkyline, unit, previewRng, building.type, building.height);
+            }
+        }
+        stream->publish(std::move(batch));
+        streamedBuildings = end;
+    }
+}
+
+void CityGenerator::placeBuildingsRandom(const CityConfig& config, std::mt19937& rng) {
+    // Generate random position with better margins
+    int margin = static_cast<int>(edgeMargin);
+    std::uniform_int_distribution<int> xDist(margin, worldWidth - margin);
+    std::uniform_int_distribution<int> yDist(margin, worldHeight - margin);
     
-    float buildingLeft = x - halfWidth;
-    float buildingRight = x + halfWidth;
-    float buildingTop = y - halfDepth;
-    float buildingBottom = y + halfDepth;
+    // Budgeted on the buildings still missing, since BLOCK_LOTS hands over
+    // the ones it found no lots for
+    int attempts = 0;
+    int missing = config.numBuildings - static_cast<int>(cityData.buildings.size());
+    int maxAttempts = missing * 50; // Increased attempts for stricter collision checks
     
-    // Check screen boundaries with margin
-    const float screenMargin = 60.0f;
-    if (buildingLeft < screenMargin || buildingRight > screenWidth - screenMargin ||
-        buildingTop < screenMargin || buildingBottom > screenHeight - screenMargin) {
-        return false; // Too close to screen edges
-    }
-    
-    // 1. Check overlap with existing buildings (STRICT - no touching)
-    for (const auto& existingBuilding : cityData.buildings) {
-        float existingHalfWidth = existingBuilding.width / 2.0f;
-        float existingHalfDepth = existingBuilding.depth / 2.0f;
-        float existingLeft = existingBuilding.x - existingHalfWidth;
-        float existingRight = existingBuilding.x + existingHalfWidth;
-        float existingTop = existingBuilding.y - existingHalfDepth;
-        float existingBottom = existingBuilding.y + existingHalfDepth;
-        
-        // Check AABB collision with strict buffer
-        // Buildings must have at least 'buildingBuffer' pixels between them
-        if (!(buildingRight + buildingBuffer < existingLeft ||
-              buildingLeft - buildingBuffer > existingRight ||
-              buildingBottom + buildingBuffer < existingTop ||
-              buildingTop - buildingBuffer > existingBottom)) {
-            return false; // Buildings too close or overlapping
-        }
+    while (cityData.buildings.size() < (size_t)config.numBuildings && attempts < maxAttempts && !cancelled()) {
+        attempts++;
+        
+        float x = xDist(rng);
+        float y = yDist(rng);
+        tryPlaceBuilding(x, y, config, rng);
     }
+}
+
+void CityGenerator::placeBuildingsPoissonDisk(const CityConfig& config, std::mt19937& rng) {
+    const int candidatesPerPoint = 30;  // Bridson's k
     
-    // 2. Check overlap with parks (STRICT - check ALL park points)
-    const float parkBuffer = 35.0f; // Increased buffer around parks
+    // Two footprints are clear of each other once their centres are more than
+    // size + buffer apart along either axis, so samples are spaced in the
+    // Chebyshev (L-infinity) metric using the expected footprint. Random sizes
+    // can still collide at this spacing; tryPlaceBuilding() catches those.
+    float typicalSize = config.useStandardSize
+        ? std::max(config.standardWidth, config.standardDepth)
+        : (MIN_RANDOM_BUILDING_SIZE + MAX_RANDOM_BUILDING_SIZE) / 2.0f;
+    float spacing = typicalSize + BUILDING_BUFFER + 1.0f;
     
-    for (const auto& park : cityData.parks) {
-        if (park.empty()) continue;
+    // Background grid with cells of side 'spacing' holds at most one sample
+    // per cell, so spacing checks only look at the 3x3 neighbourhood
+    int cols = std::max(1, static_cast<int>(std::ceil(worldWidth / spacing)));
+    int rows = std::max(1, static_cast<int>(std::ceil(worldHeight / spacing)));
+    std::vector<int> background(cols * rows, -1);
+    std::vector<size_t> active;  // Buildings that may still spawn neighbours
+    
+    auto accept = [&](float x, float y) {
+        if (x < 0.0f || y < 0.0f || x >= worldWidth || y >= worldHeight) {
+            profile.placement.record(PlacementRejection::EDGE);
+            return false;
+        }
         
-        // Method 1: Check center distance (fast rejection)
-        float parkCenterX = 0, parkCenterY = 0;
-        for (const auto& point : park) {
-            parkCenterX += point.x;
-            parkCenterY += point.y;
+        int cx = static_cast<int>(x / spacing);
+        int cy = static_cast<int>(y / spacing);
+        for (int ny = std::max(0, cy - 1); ny <= std::min(rows - 1, cy + 1); ny++) {
+            for (int nx = std::max(0, cx - 1); nx <= std::min(cols - 1, cx + 1); nx++) {
+                int neighbour = background[ny * cols + nx];
+                if (neighbour < 0) continue;
+                
+                const Building& other = cityData.buildings[neighbour];
+                if (std::max(std::fabs(other.x - x), std::fabs(other.y - y)) < spacing) {
+                    profile.placement.record(PlacementRejection::BUILDING);
+                    return false;
+                }
+            }
         }
-        parkCenterX /= park.size();
-        parkCenterY /= park.size();
-        
-        // Calculate radius from center to furthest point
-        float parkRadius = 0;
-        for (const auto& point : park) {
-            float dx = point.x - parkCenterX;
-            float dy = point.y - parkCenterY;
-            float dist = std::sqrt(dx * dx + dy * dy);
-            parkRadius = std::max(parkRadius, dist);
+        
+        // Spacing is fine; roads, parks and edges are checked by the normal test
+        if (!tryPlaceBuilding(x, y, config, rng)) return false;
+        
+        background[cy * cols + cx] = cityData.buildings.size() - 1;
+        active.push_back(cityData.buildings.size() - 1);
+        return true;
+    };
+    
+    std::uniform_real_distribution<float> xDist(edgeMargin, worldWidth - edgeMargin);
+    std::uniform_real_distribution<float> yDist(edgeMargin, worldHeight - edgeMargin);
+    std::uniform_real_distribution<float> radiusDist(spacing, 2.0f * spacing);
+    std::uniform_real_distribution<float> unitDist(0.0f, 1.0f);
+    
+    // Seeds share the same attempt budget as RANDOM mode
+    int seedAttempts = 0;
+    int maxSeedAttempts = config.numBuildings * 50;
+    
+    while (cityData.buildings.size() < (size_t)config.numBuildings && !cancelled()) {
+        if (active.empty()) {
+            // Roads and parks split the city into separate regions, so when
+            // the front dies out a fresh seed is drawn anywhere
+            if (seedAttempts >= maxSeedAttempts) break;
+            seedAttempts++;
+            accept(xDist(rng), yDist(rng));
+            continue;
         }
         
-        // Check if building box intersects with park circle (with buffer)
-        float closestX = std::max(buildingLeft - parkBuffer, 
-                                 std::min(parkCenterX, buildingRight + parkBuffer));
-        float closestY = std::max(buildingTop - parkBuffer, 
-                                 std::min(parkCenterY, buildingBottom + parkBuffer));
+        // Pick a random active sample and try k candidates in the square
+        // annulus between spacing and 2 * spacing around it
+        std::uniform_int_distribution<size_t> activeDist(0, active.size() - 1);
+        size_t slot = activeDist(rng);
+        const Building& origin = cityData.buildings[active[slot]];
+        float originX = origin.x;
+        float originY = origin.y;
         
-        float dx = closestX - parkCenterX;
-        float dy = closestY - parkCenterY;
-        float distanceSquared = dx * dx + dy * dy;
-        float radiusWithBuffer = parkRadius + parkBuffer;
+        bool placed = false;
+        for (int i = 0; i < candidatesPerPoint && !placed; i++) {
+            // Random point on the perimeter of a square of half-size r
+            float r = radiusDist(rng);
+            float u = unitDist(rng) * 8.0f * r;
+            float x, y;
+            if (u < 2.0f * r)      { x = originX - r + u;            y = originY - r; }
+            else if (u < 4.0f * r) { x = originX + r;                y = originY - r + (u - 2.0f * r); }
+            else if (u < 6.0f * r) { x = originX + r - (u - 4.0f * r); y = originY + r; }
+            else                   { x = originX - r;                y = originY + r - (u - 6.0f * r); }
+            
+            placed = accept(x, y);
+        }
         
-        if (distanceSquared < radiusWithBuffer * radiusWithBuffer) {
-            return false; // Building too close to park
+        if (!placed) {
+            // Exhausted: retire this sample from the active list
+            active[slot] = active.back();
+            active.pop_back();
         }
+    }
+}
+
+void CityGenerator::placeBuildingsTiled(const CityConfig& config, uint32_t baseSeed) {
+    // Two buildings can only interact when their centres are closer than
+    // size + buffer along both axes. Tiles of the same colour in a 2x2
+    // colouring are a full tile apart, so with tiles wider than that reach
+    // they can be filled at the same time without seeing each other.
+    float maxSize = config.useStandardSize
+        ? std::max(config.standardWidth, config.standardDepth)
+        : MAX_RANDOM_BUILDING_SIZE;
+    float tileSize = std::max(maxSize + BUILDING_BUFFER + 1.0f,
+                              std::sqrt(static_cast<float>(worldWidth) * worldHeight / TARGET_TILE_COUNT));
+    
+    int cols = std::max(1, static_cast<int>(std::ceil(worldWidth / tileSize)));
+    int rows = std::max(1, static_cast<int>(std::ceil(worldHeight / tileSize)));
+    int tileCount = cols * rows;
+    
+    // Share the building count among tiles by the usable area inside the
+    // screen margins. Quotas come from rounding the running total, so they
+    // add up to exactly numBuildings.
+    std::vector<float> area(tileCount, 0.0f);
+    float totalArea = 0.0f;
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            float w = std::min((c + 1) * tileSize, worldWidth - edgeMargin) - std::max(c * tileSize, edgeMargin);
+            float h = std::min((r + 1) * tileSize, worldHeight - edgeMargin) - std::max(r * tileSize, edgeMargin);
+            area[r * cols + c] = std::max(0.0f, w) * std::max(0.0f, h);
+            totalArea += area[r * cols + c];
+        }
+    }
+    if (totalArea <= 0.0f) return;
+    
+    std::vector<int> quota(tileCount, 0);
+    float runningArea = 0.0f;
+    int assigned = 0;
+    for (int i = 0; i < tileCount; i++) {
+        runningArea += area[i];
+        int target = static_cast<int>(std::lround(config.numBuildings * runningArea / totalArea));
+        quota[i] = target - assigned;
+        assigned = target;
+    }
+    
+    unsigned int workerCount = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::vector<Building>> results(tileCount);
+    std::vector<PlacementCounts> counts(tileCount);
+    
+    // Four phases, one per tile colour. Workers only read the shared city
+    // while a phase runs; their results are merged in tile order between
+    // phases, so the outcome does not depend on thread scheduling.
+    for (int phase = 0; phase < 4; phase++) {
+        std::vector<int> tiles;
+        for (int r = phase / 2; r < rows; r += 2) {
+            for (int c = phase % 2; c < cols; c += 2) {
+                if (quota[r * cols + c] > 0) {
+                    tiles.push_back(r * cols + c);
+                }
+            }
+        }
+        
+        std::atomic<size_t> nextTile(0);
+        auto worker = [&]() {
+            for (size_t i = nextTile++; i < tiles.size() && !cancelled(); i = nextTile++) {
+                int tile = tiles[i];
+                int c = tile % cols;
+                int r = tile / cols;
+                std::seed_seq tileSeed{ baseSeed, static_cast<uint32_t>(tile) };
+                std::mt19937 rng(tileSeed);
+                results[tile] = fillTile(c * tileSize, r * tileSize,
+                                         std::min((c + 1) * tileSize, static_cast<float>(worldWidth)),
+                                         std::min((r + 1) * tileSize, static_cast<float>(worldHeight)),
+                                         quota[tile], config, rng, counts[tile]);
+            }
+        };
         
-        // Method 2: Check individual park points (thorough verification)
-        for (const auto& point : park) {
-            // Check if any park point is inside or near building box
-            if (point.x >= buildingLeft - parkBuffer && 
-                point.x <= buildingRight + parkBuffer &&
-                point.y >= buildingTop - parkBuffer && 
-                point.y <= buildingBottom + parkBuffer) {
-                return false; // Park point too close to building
+        // Allocations on the helper threads are added to the profile, since
+        // its timers only see this thread's
+        std::atomic<uint64_t> helperBytes(0);
+        std::vector<std::thread> threads;
+        for (unsigned int t = 1; t < std::min<size_t>(workerCount, tiles.size()); t++) {
+            threads.emplace_back([&]() {
+                uint64_t before = threadAllocatedBytes();
+                worker();
+                helperBytes += threadAllocatedBytes() - before;
+            });
+        }
+        worker();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        profile.helperBytes += helperBytes.load();
+        if (cancelled()) return;
+        
+        for (int tile : tiles) {
+            profile.placement.merge(counts[tile]);
+            for (const auto& building : results[tile]) {
+                addBuilding(building);
             }
         }
     }
+}
+
+void CityGenerator::placeBuildingsInLots(const CityConfig& config, std::mt19937& rng) {
+    // Lots keep their distance from roads, parks and the world edge, less
+    // the inset every building keeps inside its lot
+    std::vector<float> roadClearance;
+    roadClearance.reserve(cityData.roads.size());
+    for (const auto& road : cityData.roads) {
+        roadClearance.push_back(std::max(0.0f, road.width / 2.0f + ROAD_BUFFER - LOT_INSET));
+    }
     
-    // 3. Check overlap with fountain (same as parks)
+    std::vector<KeepOutCircle> keepOut;
+    for (const auto& park : cityData.parks) {
+        keepOut.emplace_back(park.centerX, park.centerY, park.radius + PARK_BUFFER, PARK_BUFFER - LOT_INSET);
+    }
     if (!cityData.fountain.empty()) {
-        const float fountainBuffer = 35.0f;
+        const Circle& fountain = cityData.fountain;
+        keepOut.emplace_back(fountain.centerX, fountain.centerY, fountain.radius + FOUNTAIN_BUFFER,
+                             FOUNTAIN_BUFFER - LOT_INSET);
+    }
+    
+    BlockPartition partition;
+    partition.build(cityData.roads, roadClearance,
+                    static_cast<int>(std::ceil(edgeMargin - LOT_INSET)),
+                    static_cast<int>(std::ceil(edgeMargin - LOT_INSET)),
+                    static_cast<int>(std::floor(worldWidth - edgeMargin + LOT_INSET)),
+                    static_cast<int>(std::floor(worldHeight - edgeMargin + LOT_INSET)));
+    
+    // Standard buildings get lots that fit them exactly. Random sizes share
+    // the block area out evenly, within the range of building sizes.
+    float lotWidth, lotDepth, minWidth, minDepth;
+    if (config.useStandardSize) {
+        lotWidth = minWidth = config.standardWidth + 2.0f * LOT_INSET;
+        lotDepth = minDepth = config.standardDepth + 2.0f * LOT_INSET;
+    } else {
+        minWidth = minDepth = MIN_RANDOM_BUILDING_SIZE + 2.0f * LOT_INSET;
+        float side = std::sqrt(partition.totalArea() / config.numBuildings);
+        lotWidth = lotDepth = std::min(std::max(side, minWidth), MAX_RANDOM_BUILDING_SIZE + 2.0f * LOT_INSET);
+    }
+    
+    std::vector<Lot> lots = partition.subdivide(lotWidth, lotDepth, minWidth, minDepth, keepOut);
+    std::cout << "   - " << partition.getBlocks().size() << " blocks, " << lots.size() << " lots\n";
+    if (cancelled()) return;
+    
+    // With more lots than buildings, take an evenly spread subset; lots are
+    // in block order, so every block keeps its share
+    size_t wanted = std::min(lots.size(), static_cast<size_t>(config.numBuildings));
+    std::uniform_real_distribution<float> unitDist(0.0f, 1.0f);
+    for (size_t i = 0; i < wanted; i++) {
+        const Lot& lot = lots[i * lots.size() / wanted];
+        float innerWidth = lot.maxX - lot.minX - 2.0f * LOT_INSET;
+        float innerDepth = lot.maxY - lot.minY - 2.0f * LOT_INSET;
         
-        // Calculate fountain center
-        float fountainCenterX = 0, fountainCenterY = 0;
-        for (const auto& point : cityData.fountain) {
-            fountainCenterX += point.x;
-            fountainCenterY += point.y;
-        }
-        fountainCenterX /= cityData.fountain.size();
-        fountainCenterY /= cityData.fountain.size();
-        
-        // Calculate fountain radius
-        float fountainRadius = 0;
-        for (const auto& point : cityData.fountain) {
-            float dx = point.x - fountainCenterX;
-            float dy = point.y - fountainCenterY;
-            float dist = std::sqrt(dx * dx + dy * dy);
-            fountainRadius = std::max(fountainRadius, dist);
-        }
+        float width, depth;
+        rollBuildingSize(config, rng, width, depth);
+        width = std::min(width, innerWidth);
+        depth = std::min(depth, innerDepth);
+        
+        // Any slack in the lot becomes a random setback
+        float x = lot.minX + LOT_INSET + width / 2.0f + unitDist(rng) * (innerWidth - width);
+        float y = lot.minY + LOT_INSET + depth / 2.0f + unitDist(rng) * (innerDepth - depth);
+        profile.placement.record(PlacementRejection::NONE);
+        addBuilding(Building(x, y, width, depth, 0.0f, BuildingType::LOW_RISE));
+    }
+    
+    // Blocks too irregular to subdivide, common in ORGANIC networks, can
+    // leave fewer lots than buildings. The rest are placed freely; the lot
+    // buildings are already in the obstacle grid, so they are avoided.
+    if (wanted < static_cast<size_t>(config.numBuildings)) {
+        profile.lotShortfall = config.numBuildings - wanted;
+        std::cout << "   - " << profile.lotShortfall << " buildings without a lot, placing them freely\n";
+        placeBuildingsRandom(config, rng);
+    }
+}
+
+std::vector<Building> CityGenerator::fillTile(float minX, float minY, float maxX, float maxY, int quota,
+                                              const CityConfig& config, std::mt19937& rng,
+                                              PlacementCounts& counts) const {
+    std::vector<Building> placed;
+    
+    // Broadphase over this tile's own buildings, in tile-local coordinates
+    SpatialGrid localGrid;
+    localGrid.reset(static_cast<int>(std::ceil(maxX - minX)), static_cast<int>(std::ceil(maxY - minY)),
+                    obstacleCellSize(config));
+    float reach = (config.useStandardSize
+        ? std::max(config.standardWidth, config.standardDepth)
+        : MAX_RANDOM_BUILDING_SIZE) + BUILDING_BUFFER;
+    
+    std::uniform_real_distribution<float> xDist(minX, maxX);
+    std::uniform_real_distribution<float> yDist(minY, maxY);
+    
+    int attempts = 0;
+    int maxAttempts = quota * 50;  // Same budget per building as RANDOM mode
+    
+    while (static_cast<int>(placed.size()) < quota && attempts < maxAttempts) {
+        attempts++;
         
-        // Check if building box intersects with fountain circle
-        float closestX = std::max(buildingLeft - fountainBuffer, 
-                                 std::min(fountainCenterX, buildingRight + fountainBuffer));
-        float closestY = std::max(buildingTop - fountainBuffer, 
-                                 std::min(fountainCenterY, buildingBottom + fountainBuffer));
+        float x = xDist(rng);
+        float y = yDist(rng);
+        float width, depth;
+        rollBuildingSize(config, rng, width, depth);
         
-        float dx = closestX - fountainCenterX;
-        float dy = closestY - fountainCenterY;
-        float distanceSquared = dx * dx + dy * dy;
-        float radiusWithBuffer = fountainRadius + fountainBuffer;
+        // Earlier phases are already in the shared city; this tile's own
+        // buildings are not, so they are checked here
+        PlacementRejection cause = checkBuildingPosition(x, y, width, depth);
+        if (cause != PlacementRejection::NONE) {
+            counts.record(cause);
+            continue;
+        }
         
-        if (distanceSquared < radiusWithBuffer * radiusWithBuffer) {
-            return false; // Building too close to fountain
+        bool clear = localGrid.forEachInRange(x - minX - reach, y - minY - reach,
+                                              x - minX + reach, y - minY + reach,
+                                              [&](const GridEntry& entry) {
+            return !buildingsTooClose(x, y, width, depth, placed[entry.index]);
+        });
+        if (!clear) {
+            counts.record(PlacementRejection::BUILDING);
+            continue;
         }
+        
+        counts.record(PlacementRejection::NONE);
+        placed.emplace_back(x, y, width, depth, 0.0f, BuildingType::LOW_RISE);
+        localGrid.insert(GridEntry(GridEntryKind::BUILDING, placed.size() - 1),
+                         x - minX, y - minY, x - minX, y - minY);
     }
     
-    // 4. Check overlap with roads (since roads are now generated before buildings)
-    const float roadBuffer = 5.0f; // Small buffer around roads
+    return placed;
+}
+
+bool CityGenerator::tryPlaceBuilding(float x, float y, const CityConfig& config, std::mt19937& rng) {
+    float width, depth;
+    rollBuildingSize(config, rng, width, depth);
+    
+    // Check if position is valid (doesn't overlap roads/parks)
+    PlacementRejection cause = checkBuildingPosition(x, y, width, depth);
+    profile.placement.record(cause);
+    if (cause != PlacementRejection::NONE) {
+        return false;
+    }
     
-    for (const auto& road : cityData.roads) {
-        if (road.points.empty()) continue;
+    // Height and type are assigned by the HEIGHTS stage
+    addBuilding(Building(x, y, width, depth, 0.0f, BuildingType::LOW_RISE));
+    return true;
+}
+
+void CityGenerator::addBuilding(const Building& building) {
+    float halfWidth = building.width / 2.0f;
+    float halfDepth = building.depth / 2.0f;
+    
+    // Create and add building
+    cityData.buildings.push_back(building);
+    obstacleGrid.insert(GridEntry(GridEntryKind::BUILDING, cityData.buildings.size() - 1),
+                        building.x - halfWidth, building.y - halfDepth,
+                        building.x + halfWidth, building.y + halfDepth);
+    if (collisionBackend == CollisionBackend::RASTER) {
+        occupancy.stampRect(building.x - halfWidth - BUILDING_BUFFER, building.y - halfDepth - BUILDING_BUFFER,
+                            building.x + halfWidth + BUILDING_BUFFER, building.y + halfDepth + BUILDING_BUFFER);
+    }
+    
+    if (stream && cityData.buildings.size() - streamedBuildings >= STREAM_BATCH_SIZE) {
+        streamNewBuildings();
+    }
+    
+    if (cityData.buildings.size() % progressStride == 0) {
+        std::cout << "   - Generated " << cityData.buildings.size() << " buildings...\n" << std::flush;
+        reportProgress(GenerationStage::PLACEMENT,
+                       static_cast<float>(cityData.buildings.size()) / std::max<size_t>(1, buildingTarget));
+    }
+}
+
+PlacementRejection CityGenerator::checkBuildingPosition(float x, float y, float width, float depth) const {
+    // Calculate building bounding box with generous margins
+    float halfWidth = width / 2.0f;
+    float halfDepth = depth / 2.0f;
+    
+    float buildingLeft = x - halfWidth;
+    float buildingRight = x + halfWidth;
+    float buildingTop = y - halfDepth;
+    float buildingBottom = y + halfDepth;
+    
+    // Check screen boundaries with margin
+    if (buildingLeft < edgeMargin || buildingRight > worldWidth - edgeMargin ||
+        buildingTop < edgeMargin || buildingBottom > worldHeight - edgeMargin) {
+        return PlacementRejection::EDGE; // Too close to screen edges
+    }
+    
+    // RASTER backend: obstacles were stamped already grown by their buffers,
+    // so only the exact footprint needs to be free
+    if (collisionBackend == CollisionBackend::RASTER) {
+        return occupancy.isRectFree(buildingLeft, buildingTop, buildingRight, buildingBottom)
+            ? PlacementRejection::NONE : PlacementRejection::OCCUPIED;
+    }
+    
+    // Check if building box (grown by buffer) intersects a circle (grown by buffer)
+    auto circleOverlapsBox = [&](const Circle& circle, float buffer) {
+        if (circle.empty()) return false;
         
-        // Check if building intersects with any road point
-        for (const auto& point : road.points) {
-            // Expand road point by road width
-            float roadHalfWidth = road.width / 2.0f;
+        float closestX = std::max(buildingLeft - buffer, 
+                                 std::min(static_cast<float>(circle.centerX), buildingRight + buffer));
+        float closestY = std::max(buildingTop - buffer, 
+                                 std::min(static_cast<float>(circle.centerY), buildingBottom + buffer));
+        
+        float dx = closestX - circle.centerX;
+        float dy = closestY - circle.centerY;
+        float radiusWithBuffer = circle.radius + buffer;
+        return dx * dx + dy * dy < radiusWithBuffer * radiusWithBuffer;
+    };
+    
+    // Only elements within the largest buffer of the building can collide,
+    // so the grid query is limited to that neighbourhood
+    float reach = std::max(std::max(BUILDING_BUFFER, PARK_BUFFER),
+                           std::max(FOUNTAIN_BUFFER, ROAD_BUFFER + maxRoadHalfWidth));
+    
+    PlacementRejection cause = PlacementRejection::NONE;
+    obstacleGrid.forEachInRange(buildingLeft - reach, buildingTop - reach,
+                                       buildingRight + reach, buildingBottom + reach,
+                                       [&](const GridEntry& entry) {
+        switch (entry.kind) {
+            case GridEntryKind::BUILDING: {
+                // 1. Check overlap with existing buildings (STRICT - no touching)
+                if (buildingsTooClose(x, y, width, depth, cityData.buildings[entry.index])) {
+                    cause = PlacementRejection::BUILDING;
+                    return false; // Buildings too close or overlapping
+                }
+                return true;
+            }
+            
+            case GridEntryKind::PARK: {
+                // 2. Check overlap with parks
+                const Circle& park = cityData.parks[entry.index];
+                if (circleOverlapsBox(park, PARK_BUFFER)) {
+                    cause = PlacementRejection::PARK;
+                    return false; // Building too close to park
+                }
+                return true;
+            }
             
-            if (point.x >= buildingLeft - roadBuffer - roadHalfWidth && 
-                point.x <= buildingRight + roadBuffer + roadHalfWidth &&
-                point.y >= buildingTop - roadBuffer - roadHalfWidth && 
-                point.y <= buildingBottom + roadBuffer + roadHalfWidth) {
-                return false; // Building too close to road
+            case GridEntryKind::FOUNTAIN: {
+                // 3. Check overlap with fountain (same as parks)
+                if (circleOverlapsBox(cityData.fountain, FOUNTAIN_BUFFER)) {
+                    cause = PlacementRejection::FOUNTAIN;
+                    return false; // Building too close to fountain
+                }
+                return true;
+            }
+            
+            case GridEntryKind::ROAD: {
+                // 4. Check overlap with roads (since roads are now generated before buildings)
+                const Road& road = cityData.roads[entry.index];
+                
+                // Exact test: the road is every point within half its width
+                // of the centre line, and must stay ROAD_BUFFER away from the box
+                float clearance = road.width / 2.0f + ROAD_BUFFER;
+                
+                if (thickSegmentOverlapsBox(road.x0(), road.y0(), road.x1(), road.y1(), clearance,
+                                            buildingLeft, buildingTop, buildingRight, buildingBottom)) {
+                    cause = PlacementRejection::ROAD;
+                    return false; // Building too close to road
+                }
+                return true;
             }
         }
-    }
-    
-    return true; // Position is valid - no overlaps detected
+        return true;
+    });
+    return cause; // Position is valid only if no nearby element rejected it
 }
@@ -0,0 +1,46 @@
+#include "generation/city_stream.h"
+#include <chrono>
+#include <thread>
+#include <utility>
+
+CityStream::CityStream() : closed(false) {
+}
+
+void CityStream::publish(CityBatch&& batch) {
+    // Keep batches in order: nothing jumps ahead of the backlog
+    if (drainBacklog() && queue.tryPush(std::move(batch))) {
+        return;
+    }
+
+    // The renderer is behind. Appending buildings to a waiting building
+    // batch keeps the backlog short without changing what gets applied.
+    if (!backlog.empty() && batch.kind == CityBatchKind::BUILDINGS && !batch.restart &&
+        backlog.back().kind == CityBatchKind::BUILDINGS) {
+        std::vector<Building>& waiting = backlog.back().buildings;
+        waiting.insert(waiting.end(), batch.buildings.begin(), batch.buildings.end());
+        return;
+    }
+    backlog.push_back(std::move(batch));
+}
+
+void CityStream::flush() {
+    // The render thread empties the queue every frame, so this waits at
+    // most about a frame per queue-full of batches
+    while (!drainBacklog() && !closed.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void CityStream::close() {
+    closed = true;
+}
+
+bool CityStream::drainBacklog() {
+    while (!backlog.empty()) {
+        if (!queue.tryPush(std::move(backlog.front()))) {
+            return false;
+        }
+        backlog.pop_front();
+    }
+    return true;
+}
@@ -0,0 +1,140 @@
+#include "generation/generation_pipeline.h"
+
+static const int STAGE_COUNT = static_cast<int>(GenerationStage::COUNT);
+
+// FNV-1a over the raw bytes of each field
+static void hashBytes(uint64_t& hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+}
+
+template <typename T>
+static void hashValue(uint64_t& hash, const T& value) {
+    hashBytes(hash, &value, sizeof(value));
+}
+
+GenerationPipeline::GenerationPipeline() {
+    invalidate();
+}
+
+StageMask GenerationPipeline::dependencies(GenerationStage stage) {
+    switch (stage) {
+        case GenerationStage::ROAD_CLIPPING:
+            return stageBit(GenerationStage::PARKS) | stageBit(GenerationStage::ROAD_LAYOUT);
+        case GenerationStage::PLACEMENT:
+            // Buildings avoid parks and clipped roads
+            return stageBit(GenerationStage::PARKS) | stageBit(GenerationStage::ROAD_CLIPPING);
+        case GenerationStage::HEIGHTS:
+            return stageBit(GenerationStage::PLACEMENT);
+        case GenerationStage::PARKS:
+        case GenerationStage::ROAD_LAYOUT:
+        default:
+            return 0;
+    }
+}
+
+uint64_t GenerationPipeline::fingerprint(GenerationStage stage, const CityConfig& config) {
+    uint64_t hash = 14695981039346656037ULL;
+    hashValue(hash, static_cast<int>(stage));
+
+    switch (stage) {
+        case GenerationStage::PARKS:
+            hashValue(hash, config.world.width);
+            hashValue(hash, config.world.height);
+            hashValue(hash, config.world.margin);
+            hashValue(hash, config.seed);
+            hashValue(hash, config.numParks);
+            hashValue(hash, config.parkRadius);
+            hashValue(hash, config.fountainRadius);
+            break;
+        case GenerationStage::ROAD_LAYOUT:
+            hashValue(hash, config.world.width);
+            hashValue(hash, config.world.height);
+            hashValue(hash, config.world.margin);
+            hashValue(hash, config.seed);
+            hashValue(hash, config.layoutSize);
+            hashValue(hash, static_cast<int>(config.roadPattern));
+            break;
+        case GenerationStage::ROAD_CLIPPING:
+            hashValue(hash, config.worldRoadWidth());
+            break;
+        case GenerationStage::PLACEMENT:
+            hashValue(hash, config.world.width);
+            hashValue(hash, config.world.height);
+            hashValue(hash, config.world.margin);
+            hashValue(hash, config.seed);
+            hashValue(hash, config.numBuildings);
+            hashValue(hash, config.useStandardSize);
+            hashValue(hash, config.standardWidth);
+            hashValue(hash, config.standardDepth);
+            hashValue(hash, static_cast<int>(config.placementMode));
+            hashValue(hash, static_cast<int>(config.collisionBackend));
+            break;
+        case GenerationStage::HEIGHTS:
+            hashValue(hash, config.seed);
+            hashValue(hash, static_cast<int>(config.skylineType));
+            hashValue(hash, config.worldUnit());
+            break;
+        default:
+            break;
+    }
+    return hash;
+}
+
+StageMask GenerationPipeline::changedStages(const CityConfig& config) const {
+    StageMask changed = 0;
+    for (int s = 0; s < STAGE_COUNT; s++) {
+        GenerationStage stage = static_cast<GenerationStage>(s);
+        bool stale = !(valid & stageBit(stage)) || fingerprints[s] != fingerprint(stage, config);
+        if (stale || (dependencies(stage) & changed)) {
+            changed |= stageBit(stage);
+        }
+    }
+    return changed;
+}
+
+StageMask GenerationPipeline::stagesToRun(const CityConfig& config) const {
+    StageMask run = changedStages(config);
+
+    // Walk backwards so restoring one input can pull in its own inputs
+    for (int s = STAGE_COUNT - 1; s >= 0; s--) {
+        GenerationStage stage = static_cast<GenerationStage>(s);
+        if (!(run & stageBit(stage))) continue;
+        run |= dependencies(stage) & ~available;
+    }
+    return run;
+}
+
+void GenerationPipeline::markRan(StageMask stages, const CityConfig& config) {
+    for (int s = 0; s < STAGE_COUNT; s++) {
+        GenerationStage stage = static_cast<GenerationStage>(s);
+        if (!(stages & stageBit(stage))) continue;
+        fingerprints[s] = fingerprint(stage, config);
+    }
+    valid |= stages;
+    available |= stages;
+}
+
+void GenerationPipeline::reset(const CityConfig& config, StageMask withOutput) {
+    for (int s = 0; s < STAGE_COUNT; s++) {
+        fingerprints[s] = fingerprint(static_cast<GenerationStage>(s), config);
+    }
+    valid = ALL_STAGES;
+    available = withOutput;
+}
+
+void GenerationPipeline::markStale(StageMask stages) {
+    valid &= ~stages;
+    available &= ~stages;
+}
+
+void GenerationPipeline::invalidate() {
+    for (int s = 0; s < STAGE_COUNT; s++) {
+        fingerprints[s] = 0;
+    }
+    valid = 0;
+    available = 0;
+}
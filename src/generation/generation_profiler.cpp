@@ -0,0 +1,143 @@
+#include "generation/generation_profiler.h"
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+void PlacementCounts::clear() {
+    attempts = 0;
+    placed = 0;
+    for (auto& count : rejected) {
+        count = 0;
+    }
+}
+
+void PlacementCounts::record(PlacementRejection cause) {
+    attempts++;
+    if (cause == PlacementRejection::NONE) {
+        placed++;
+    } else {
+        rejected[static_cast<int>(cause)]++;
+    }
+}
+
+void PlacementCounts::merge(const PlacementCounts& other) {
+    attempts += other.attempts;
+    placed += other.placed;
+    for (int i = 0; i < static_cast<int>(PlacementRejection::COUNT); i++) {
+        rejected[i] += other.rejected[i];
+    }
+}
+
+void GenerationProfile::begin(const CityConfig& cityConfig) {
+    config = cityConfig;
+    cacheHit = false;
+    cancelled = false;
+    for (auto& timing : sections) {
+        timing = SectionTiming();
+    }
+    placement.clear();
+    occupancyPixelsStamped = 0;
+    lotShortfall = 0;
+    helperBytes = 0;
+}
+
+const char* GenerationProfile::sectionName(ProfileSection s) {
+    switch (s) {
+        case ProfileSection::GENERATE_CITY:  return "generateCity";
+        case ProfileSection::CACHE_LOOKUP:   return "cacheLookup";
+        case ProfileSection::PARKS:          return "generateParks";
+        case ProfileSection::ROAD_LAYOUT:    return "generateRoads";
+        case ProfileSection::ROAD_CLIPPING:  return "clipRoads";
+        case ProfileSection::ROAD_GRAPH:     return "buildRoadGraph";
+        case ProfileSection::OBSTACLE_INDEX: return "indexObstacles";
+        case ProfileSection::PLACEMENT:      return "generateBuildings";
+        case ProfileSection::HEIGHTS:        return "assignHeights";
+        case ProfileSection::STREAM_FLUSH:   return "streamFlush";
+        case ProfileSection::CACHE_STORE:    return "cacheStore";
+        default:                             return "unknown";
+    }
+}
+
+const char* GenerationProfile::rejectionName(PlacementRejection cause) {
+    switch (cause) {
+        case PlacementRejection::NONE:     return "none";
+        case PlacementRejection::EDGE:     return "edge";
+        case PlacementRejection::BUILDING: return "building";
+        case PlacementRejection::PARK:     return "park";
+        case PlacementRejection::FOUNTAIN: return "fountain";
+        case PlacementRejection::ROAD:     return "road";
+        case PlacementRejection::OCCUPIED: return "occupied";
+        default:                           return "unknown";
+    }
+}
+
+std::string GenerationProfile::toJson() const {
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(3);
+
+    json << "{\n";
+    json << "  \"config\": {\n";
+    json << "    \"seed\": " << config.seed << ",\n";
+    json << "    \"scaleTier\": \"" << config.getScaleTierString() << "\",\n";
+    json << "    \"worldWidth\": " << static_cast<int>(config.world.width) << ",\n";
+    json << "    \"worldHeight\": " << static_cast<int>(config.world.height) << ",\n";
+    json << "    \"numBuildings\": " << config.numBuildings << ",\n";
+    json << "    \"layoutSize\": " << config.layoutSize << ",\n";
+    json << "    \"roadPattern\": \"" << config.getRoadPatternString() << "\",\n";
+    json << "    \"placementMode\": \"" << config.getPlacementModeString() << "\",\n";
+    json << "    \"collisionBackend\": \"" << config.getCollisionBackendString() << "\"\n";
+    json << "  },\n";
+    json << "  \"cacheHit\": " << (cacheHit ? "true" : "false") << ",\n";
+    json << "  \"cancelled\": " << (cancelled ? "true" : "false") << ",\n";
+    json << "  \"allocationsCounted\": " << (allocationsCounted() ? "true" : "false") << ",\n";
+
+    json << "  \"sections\": {";
+    bool first = true;
+    for (int s = 0; s < static_cast<int>(ProfileSection::COUNT); s++) {
+        const SectionTiming& timing = sections[s];
+        if (timing.calls == 0) continue;
+
+        json << (first ? "\n" : ",\n");
+        json << "    \"" << sectionName(static_cast<ProfileSection>(s)) << "\": { "
+             << "\"ms\": " << timing.milliseconds << ", ";
+        if (allocationsCounted()) {
+            json << "\"bytesAllocated\": " << timing.bytesAllocated << ", ";
+        }
+        json << "\"calls\": " << timing.calls << " }";
+        first = false;
+    }
+    json << (first ? "},\n" : "\n  },\n");
+
+    json << "  \"placement\": {\n";
+    json << "    \"attempts\": " << placement.attempts << ",\n";
+    json << "    \"placed\": " << placement.placed << ",\n";
+    json << "    \"rejections\": {";
+    for (int c = static_cast<int>(PlacementRejection::EDGE); c < static_cast<int>(PlacementRejection::COUNT); c++) {
+        json << (c == static_cast<int>(PlacementRejection::EDGE) ? " " : ", ")
+             << "\"" << rejectionName(static_cast<PlacementRejection>(c)) << "\": " << placement.rejected[c];
+    }
+    json << " }\n";
+    json << "  },\n";
+    json << "  \"occupancyPixelsStamped\": " << occupancyPixelsStamped << ",\n";
+    json << "  \"lotShortfall\": " << lotShortfall << "\n";
+    json << "}\n";
+    return json.str();
+}
+
+bool GenerationProfile::saveJson(const std::string& path) const {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) return false;
+    out << toJson();
+    return static_cast<bool>(out);
+}
+
+ProfileScope::ProfileScope(GenerationProfile& target, ProfileSection s)
+    : profile(target), section(s), start(std::chrono::steady_clock::now()), startBytes(allocatedBytes()) {
+}
+
+ProfileScope::~ProfileScope() {
+    SectionTiming& timing = profile.sections[static_cast<int>(section)];
+    timing.milliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    timing.bytesAllocated += allocatedBytes() - startBytes;
+    timing.calls++;
+}
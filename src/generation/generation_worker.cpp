@@ -0,0 +1,66 @@
+#include "generation/generation_worker.h"
+
+GenerationWorker::GenerationWorker()
+    : hasPending(false), stopping(false), hasProfile(false), cancelRequested(false), busy(false) {
+    generator.setStream(&stream);
+    thread = std::thread(&GenerationWorker::run, this);
+}
+
+GenerationWorker::~GenerationWorker() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        cancelRequested = true;
+    }
+    stream.close();
+    wake.notify_one();
+    thread.join();
+}
+
+void GenerationWorker::request(const CityConfig& config) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pendingConfig = config;
+        hasPending = true;
+        busy = true;
+
+        // Whatever is running is out of date now
+        cancelRequested = true;
+    }
+    wake.notify_one();
+}
+
+bool GenerationWorker::getProfile(GenerationProfile& out) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!hasProfile) return false;
+    out = lastProfile;
+    return true;
+}
+
+void GenerationWorker::run() {
+    while (true) {
+        CityConfig config;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this]() { return hasPending || stopping; });
+            if (stopping) return;
+
+            config = pendingConfig;
+            hasPending = false;
+
+            // Cleared under the lock, so only a request made after this one
+            // was taken can cancel it
+            cancelRequested = false;
+        }
+
+        // Cancelled or not, everything the run changed has been streamed
+        generator.generateCity(config, &cancelRequested);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        lastProfile = generator.getProfile();
+        hasProfile = true;
+        if (!hasPending) {
+            busy = false;
+        }
+    }
+}
@@ -0,0 +1,197 @@
+#include "generation/occupancy_grid.h"
+#include <algorithm>
+#include <cmath>
+
+// Mask with bits [lo, hi] set (0 <= lo <= hi <= 63)
+static uint64_t bitRange(int lo, int hi) {
+    uint64_t upper = (hi == 63) ? ~0ULL : ((1ULL << (hi + 1)) - 1);
+    uint64_t lower = (1ULL << lo) - 1;
+    return upper & ~lower;
+}
+
+// Intersect [lo, hi] with the solutions u of cLo <= a * u <= cHi
+static bool clipLinear(float a, float cLo, float cHi, float& lo, float& hi) {
+    if (a == 0.0f) {
+        return cLo <= 0.0f && 0.0f <= cHi;
+    }
+    float u0 = cLo / a;
+    float u1 = cHi / a;
+    lo = std::max(lo, std::min(u0, u1));
+    hi = std::min(hi, std::max(u0, u1));
+    return lo <= hi;
+}
+
+// X-extent of a capsule (segment thickened by h) along the line y = yy.
+// The capsule is the union of two end discs and the slab between them.
+static bool capsuleSpanAt(float yy, float x0, float y0, float x1, float y1, float h,
+                          float& spanLo, float& spanHi) {
+    bool found = false;
+    auto merge = [&](float lo, float hi) {
+        spanLo = found ? std::min(spanLo, lo) : lo;
+        spanHi = found ? std::max(spanHi, hi) : hi;
+        found = true;
+    };
+
+    // End discs
+    float ends[2][2] = { { x0, y0 }, { x1, y1 } };
+    for (const auto& end : ends) {
+        float dy = yy - end[1];
+        if (std::fabs(dy) <= h) {
+            float half = std::sqrt(h * h - dy * dy);
+            merge(end[0] - half, end[0] + half);
+        }
+    }
+
+    // Slab: projection onto the segment within [0, L^2] and
+    // perpendicular distance within h * L, both linear in u = x - x0
+    float dx = x1 - x0;
+    float dy = y1 - y0;
+    float lengthSquared = dx * dx + dy * dy;
+    if (lengthSquared > 0.0f) {
+        float length = std::sqrt(lengthSquared);
+        float ry = yy - y0;
+        float lo = -1e30f;
+        float hi = 1e30f;
+        if (clipLinear(dx, -ry * dy, lengthSquared - ry * dy, lo, hi) &&
+            clipLinear(-dy, -h * length - ry * dx, h * length - ry * dx, lo, hi)) {
+            merge(x0 + lo, x0 + hi);
+        }
+    }
+
+    return found;
+}
+
+OccupancyGrid::OccupancyGrid() : width(0), height(0), wordsPerRow(0), stampedPixels(0) {
+}
+
+void OccupancyGrid::reset(int w, int h) {
+    width = std::max(0, w);
+    height = std::max(0, h);
+    wordsPerRow = (width + 63) / 64;
+    stampedPixels = 0;
+
+    bits.assign(static_cast<size_t>(wordsPerRow) * height, 0ULL);
+}
+
+void OccupancyGrid::fillSpan(int y, int x0, int x1) {
+    if (y < 0 || y >= height) return;
+    x0 = std::max(0, x0);
+    x1 = std::min(width - 1, x1);
+    if (x0 > x1) return;
+    stampedPixels += x1 - x0 + 1;
+
+    uint64_t* row = &bits[static_cast<size_t>(y) * wordsPerRow];
+    int w0 = x0 >> 6;
+    int w1 = x1 >> 6;
+
+    if (w0 == w1) {
+        row[w0] |= bitRange(x0 & 63, x1 & 63);
+        return;
+    }
+
+    row[w0] |= bitRange(x0 & 63, 63);
+    for (int w = w0 + 1; w < w1; w++) {
+        row[w] = ~0ULL;
+    }
+    row[w1] |= bitRange(0, x1 & 63);
+}
+
+bool OccupancyGrid::rowRange(float minY, float maxY, int& y0, int& y1) const {
+    y0 = std::max(0, static_cast<int>(std::floor(minY)));
+    y1 = std::min(height - 1, static_cast<int>(std::floor(maxY)));
+    return y0 <= y1;
+}
+
+void OccupancyGrid::stampRect(float minX, float minY, float maxX, float maxY) {
+    int y0, y1;
+    if (!rowRange(minY, maxY, y0, y1)) return;
+
+    int x0 = static_cast<int>(std::floor(minX));
+    int x1 = static_cast<int>(std::floor(maxX));
+    for (int y = y0; y <= y1; y++) {
+        fillSpan(y, x0, x1);
+    }
+}
+
+void OccupancyGrid::stampSpans(const PixelSpan* spans, size_t count, int pad) {
+    if (count == 0) return;
+    pad = std::max(0, pad);
+    int rows = static_cast<int>(count);
+    int top = spans[0].y;
+
+    // Output row r is the widest of the runs within pad rows of it, widened
+    // by the pad; rows outside the raster are skipped up front
+    int first = std::max(-pad, -top);
+    int last = std::min(rows - 1 + pad, height - 1 - top);
+    for (int r = first; r <= last; r++) {
+        int from = std::max(0, r - pad);
+        int to = std::min(rows - 1, r + pad);
+        int lo = spans[from].x;
+        int hi = spans[from].x + spans[from].length - 1;
+        for (int i = from + 1; i <= to; i++) {
+            lo = std::min(lo, spans[i].x);
+            hi = std::max(hi, spans[i].x + spans[i].length - 1);
+        }
+        fillSpan(top + r, lo - pad, hi + pad);
+    }
+}
+
+void OccupancyGrid::stampThickSegment(float x0, float y0, float x1, float y1, float halfWidth) {
+    int rowStart, rowEnd;
+    if (!rowRange(std::min(y0, y1) - halfWidth, std::max(y0, y1) + halfWidth, rowStart, rowEnd)) return;
+
+    for (int y = rowStart; y <= rowEnd; y++) {
+        // The capsule is convex, so its x-extent within the row band is
+        // reached on one of the band edges or at an end-disc extreme
+        float lo = 0.0f, hi = 0.0f;
+        bool found = false;
+        auto merge = [&](float spanLo, float spanHi) {
+            lo = found ? std::min(lo, spanLo) : spanLo;
+            hi = found ? std::max(hi, spanHi) : spanHi;
+            found = true;
+        };
+
+        float spanLo, spanHi;
+        if (capsuleSpanAt(static_cast<float>(y), x0, y0, x1, y1, halfWidth, spanLo, spanHi)) {
+            merge(spanLo, spanHi);
+        }
+        if (capsuleSpanAt(static_cast<float>(y + 1), x0, y0, x1, y1, halfWidth, spanLo, spanHi)) {
+            merge(spanLo, spanHi);
+        }
+        if (y0 >= y && y0 <= y + 1) merge(x0 - halfWidth, x0 + halfWidth);
+        if (y1 >= y && y1 <= y + 1) merge(x1 - halfWidth, x1 + halfWidth);
+
+        if (found) {
+            fillSpan(y, static_cast<int>(std::floor(lo)), static_cast<int>(std::floor(hi)));
+        }
+    }
+}
+
+bool OccupancyGrid::isRectFree(float minX, float minY, float maxX, float maxY) const {
+    int y0, y1;
+    if (!rowRange(minY, maxY, y0, y1)) return true;
+
+    int x0 = std::max(0, static_cast<int>(std::floor(minX)));
+    int x1 = std::min(width - 1, static_cast<int>(std::floor(maxX)));
+    if (x0 > x1) return true;
+
+    int w0 = x0 >> 6;
+    int w1 = x1 >> 6;
+    uint64_t firstMask = bitRange(x0 & 63, w0 == w1 ? (x1 & 63) : 63);
+    uint64_t lastMask = bitRange(0, x1 & 63);
+
+    // Scan each row a word at a time; any set bit under the mask is a hit
+    for (int y = y0; y <= y1; y++) {
+        const uint64_t* row = &bits[static_cast<size_t>(y) * wordsPerRow];
+
+        if (row[w0] & firstMask) return false;
+        if (w0 == w1) continue;
+
+        for (int w = w0 + 1; w < w1; w++) {
+            if (row[w]) return false;
+        }
+        if (row[w1] & lastMask) return false;
+    }
+
+    return true;
+}
@@ -1,15 +1,28 @@
 #include "generation/road_generator.h"
+#include "utils/delaunay.h"
+#include "utils/geometry.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
-RoadGenerator::RoadGenerator(int width, int height) 
-    : screenWidth(width), screenHeight(height) {
-    // Initialize random number generator with a seed
-    std::random_device rd;
-    rng.seed(rd());
+float Road::length() const {
+    float dx = x1() - x0();
+    float dy = y1() - y0();
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+RoadGenerator::RoadGenerator() 
+    : worldWidth(0), worldHeight(0), margin(0), unit(1.0f), roadWidth(0) {
+    // Seeded per city by CityGenerator through seed()
 }
 
 std::vector<Road> RoadGenerator::generateRoads(const CityConfig& config) {
+    worldWidth = static_cast<int>(config.world.width);
+    worldHeight = static_cast<int>(config.world.height);
+    margin = static_cast<int>(config.world.margin);
+    unit = config.worldUnit();
+    roadWidth = config.worldRoadWidth();
+    
     std::cout << "\n🛣️  Generating roads (" << config.getRoadPatternString() << " pattern)...\n" << std::flush;
     
     switch(config.roadPattern) {
@@ -19,6 +32,8 @@ std::vector<Road> RoadGenerator::generateRoads(const CityConfig& config) {
             return generateRadialRoads(config);
         case RoadPattern::RANDOM:
             return generateRandomRoads(config);
+        case RoadPattern::ORGANIC:
+            return generateOrganicRoads(config);
         default:
             return generateGridRoads(config);
     }
@@ -27,22 +42,21 @@ std::vector<Road> RoadGenerator::generateRoads(const CityConfig& config) {
 std::vector<Road> RoadGenerator::generateGridRoads(const CityConfig& config) {
     std::vector<Road> roads;
     
-    int margin = 50;
-    int spacing = (screenWidth - 2 * margin) / config.layoutSize;
+    int spacing = (worldWidth - 2 * margin) / config.layoutSize;
     
     std::cout << "   - Creating " << config.layoutSize << "x" << config.layoutSize << " grid\n";
     
     // Generate horizontal roads
     for (int i = 0; i <= config.layoutSize; i++) {
         int y = margin + i * spacing;
-        Road road = createRoad(margin, y, screenWidth - margin, y, config.roadWidth);
+        Road road = createRoad(margin, y, worldWidth - margin, y, roadWidth);
         roads.push_back(road);
     }
     
     // Generate vertical roads
     for (int i = 0; i <= config.layoutSize; i++) {
         int x = margin + i * spacing;
-        Road road = createRoad(x, margin, x, screenHeight - margin, config.roadWidth);
+        Road road = createRoad(x, margin, x, worldHeight - margin, roadWidth);
         roads.push_back(road);
     }
     
@@ -54,14 +68,14 @@ std::vector<Road> RoadGenerator::generateRadialRoads(const CityConfig& config) {
     std::vector<Road> roads;
     
     // Center of the city
-    int centerX = screenWidth / 2;
-    int centerY = screenHeight / 2;
+    int centerX = worldWidth / 2;
+    int centerY = worldHeight / 2;
     
     // Number of radial roads (spokes)
     int numSpokes = config.layoutSize;
     
     // Radius for the roads
-    int maxRadius = std::min(screenWidth, screenHeight) / 2 - 50;
+    int maxRadius = std::min(worldWidth, worldHeight) / 2 - margin;
     
     std::cout << "   - Creating " << numSpokes << " radial spokes\n";
     
@@ -71,12 +85,11 @@ std::vector<Road> RoadGenerator::generateRadialRoads(const CityConfig& config) {
         int endX = centerX + static_cast<int>(maxRadius * cos(angle));
         int endY = centerY + static_cast<int>(maxRadius * sin(angle));
         
-        // Clamp endpoints to screen boundaries with margin
-        int margin = 50;
-        endX = std::max(margin, std::min(screenWidth - margin, endX));
-        endY = std::max(margin, std::min(screenHeight - margin, endY));
+        // Clamp endpoints to world boundaries with margin
+        endX = std::max(margin, std::min(worldWidth - margin, endX));
+        endY = std::max(margin, std::min(worldHeight - margin, endY));
         
-        Road road = createRoad(centerX, centerY, endX, endY, config.roadWidth);
+        Road road = createRoad(centerX, centerY, endX, endY, roadWidth);
         roads.push_back(road);
     }
     
@@ -84,35 +97,9 @@ std::vector<Road> RoadGenerator::generateRadialRoads(const CityConfig& config) {
     int numRings = config.layoutSize / 2;
     std::cout << "   - Creating " << numRings << " circular rings\n";
     
-    int margin = 50;
     for (int ring = 1; ring <= numRings; ring++) {
         int radius = (maxRadius * ring) / numRings;
-        
-        // Create circle using midpoint circle algorithm
-        std::vector<Point> circlePoints = midpointCircle(centerX, centerY, radius);
-        
-        // Filter circle points to stay within boundaries
-        std::vector<Point> validPoints;
-        for (const auto& pt : circlePoints) {
-            if (pt.x >= margin && pt.x <= screenWidth - margin &&
-                pt.y >= margin && pt.y <= screenHeight - margin) {
-                validPoints.push_back(pt);
-            }
-        }
-        
-        // Connect valid circle points to form a road
-        // Sample every few points to create line segments
-        for (size_t i = 0; i < validPoints.size(); i += 8) {
-            size_t nextIdx = (i + 8) % validPoints.size();
-            if (nextIdx < validPoints.size()) {
-                Road road = createRoad(
-                    validPoints[i].x, validPoints[i].y,
-                    validPoints[nextIdx].x, validPoints[nextIdx].y,
-                    config.roadWidth
-                );
-                roads.push_back(road);
-            }
-        }
+        appendRingRoad(roads, centerX, centerY, radius, roadWidth);
     }
     
     std::cout << "   - Generated " << roads.size() << " road segments\n";
@@ -130,14 +117,15 @@ std::vector<Road> RoadGenerator::generateRandomRoads(const CityConfig& config) {
     // Generate random connection points
     std::vector<Point> nodes;
     for (int i = 0; i < config.layoutSize * 2; i++) {
-        nodes.push_back(randomPoint());
+        nodes.push_back(randomPoint(margin));
     }
     
-    // Add screen edge points for connectivity
-    nodes.push_back(Point(100, 100));
-    nodes.push_back(Point(screenWidth - 100, 100));
-    nodes.push_back(Point(100, screenHeight - 100));
-    nodes.push_back(Point(screenWidth - 100, screenHeight - 100));
+    // Add world corner points for connectivity
+    int inset = 2 * margin;
+    nodes.push_back(Point(inset, inset));
+    nodes.push_back(Point(worldWidth - inset, inset));
+    nodes.push_back(Point(inset, worldHeight - inset));
+    nodes.push_back(Point(worldWidth - inset, worldHeight - inset));
     
     // Connect random nodes
     std::uniform_int_distribution<int> nodeDist(0, nodes.size() - 1);
@@ -150,7 +138,7 @@ std::vector<Road> RoadGenerator::generateRandomRoads(const CityConfig& config) {
             Road road = createRoad(
                 nodes[idx1].x, nodes[idx1].y,
                 nodes[idx2].x, nodes[idx2].y,
-                config.roadWidth
+                roadWidth
             );
             roads.push_back(road);
         }
@@ -160,120 +148,213 @@ std::vector<Road> RoadGenerator::generateRandomRoads(const CityConfig& config) {
     return roads;
 }
 
+std::vector<Road> RoadGenerator::generateOrganicRoads(const CityConfig& config) {
+    std::vector<Road> roads;
+    
+    // One node per cell of a layoutSize-wide grid, jittered inside its cell,
+    // so nodes are random but never clump or leave large holes
+    int cols = std::max(2, config.layoutSize);
+    float cellSize = static_cast<float>(worldWidth - 2 * margin) / cols;
+    int rows = std::max(2, static_cast<int>(std::lround((worldHeight - 2 * margin) / cellSize)));
+    float cellHeight = static_cast<float>(worldHeight - 2 * margin) / rows;
+    
+    std::cout << "   - Scattering " << cols * rows << " organic nodes\n";
+    
+    std::uniform_real_distribution<float> jitter(-ORGANIC_JITTER / 2.0f, ORGANIC_JITTER / 2.0f);
+    std::vector<Point> nodes;
+    nodes.reserve(static_cast<size_t>(cols) * rows);
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            float x = margin + (c + 0.5f + jitter(rng)) * cellSize;
+            float y = margin + (r + 0.5f + jitter(rng)) * cellHeight;
+            nodes.push_back(Point(static_cast<int>(std::lround(x)), static_cast<int>(std::lround(y))));
+        }
+    }
+    
+    // Every subset of the Delaunay edges is planar. Kruskal's algorithm over
+    // them, shortest first, gives the minimum spanning tree, which keeps the
+    // network connected; a share of the other short edges adds loops.
+    std::vector<std::pair<int, int>> edges = delaunayEdges(nodes);
+    auto lengthSquared = [&](const std::pair<int, int>& e) {
+        float dx = static_cast<float>(nodes[e.first].x - nodes[e.second].x);
+        float dy = static_cast<float>(nodes[e.first].y - nodes[e.second].y);
+        return dx * dx + dy * dy;
+    };
+    std::vector<float> edgeLength(edges.size());
+    for (size_t i = 0; i < edges.size(); i++) {
+        edgeLength[i] = lengthSquared(edges[i]);
+    }
+    std::vector<size_t> order(edges.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return edgeLength[a] < edgeLength[b] || (edgeLength[a] == edgeLength[b] && a < b);
+    });
+    
+    std::vector<int> parent(nodes.size());
+    for (size_t i = 0; i < parent.size(); i++) parent[i] = static_cast<int>(i);
+    auto find = [&](int n) {
+        while (parent[n] != n) {
+            parent[n] = parent[parent[n]];
+            n = parent[n];
+        }
+        return n;
+    };
+    
+    float maxExtra = ORGANIC_MAX_EDGE * std::max(cellSize, cellHeight);
+    std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+    int treeEdges = 0;
+    
+    for (size_t i : order) {
+        const auto& edge = edges[i];
+        int a = find(edge.first);
+        int b = find(edge.second);
+        
+        bool keep;
+        if (a != b) {
+            parent[a] = b;
+            keep = true;
+            treeEdges++;
+        } else {
+            // Draw for every candidate so the outcome depends only on the seed
+            keep = chance(rng) < ORGANIC_EXTRA_EDGES && edgeLength[i] <= maxExtra * maxExtra;
+        }
+        
+        if (keep) {
+            const Point& p = nodes[edge.first];
+            const Point& q = nodes[edge.second];
+            roads.push_back(createRoad(p.x, p.y, q.x, q.y, roadWidth));
+        }
+    }
+    
+    std::cout << "   - Kept " << treeEdges << " spanning and " << roads.size() - treeEdges
+              << " extra edges of " << edges.size() << " Delaunay edges\n";
+    std::cout << "   - Generated " << roads.size() << " road segments\n";
+    return roads;
+}
+
+void RoadGenerator::appendRingRoad(std::vector<Road>& roads, int centerX, int centerY,
+                                   int radius, int width) {
+    if (radius <= 0) return;
+    
+    // A chord over angle a deviates r * (1 - cos(a / 2)) from the arc, so
+    // pick the fewest segments that keep that sagitta within tolerance
+    float r = static_cast<float>(radius);
+    int segments = MIN_RING_SEGMENTS;
+    float tolerance = RING_CHORD_TOLERANCE * unit;
+    if (tolerance < r) {
+        float maxAngle = 2.0f * std::acos(1.0f - tolerance / r);
+        segments = std::max(segments, static_cast<int>(std::ceil(2.0f * M_PI / maxAngle)));
+    }
+    
+    // Polyline vertices on the circle, rounded once so neighbouring
+    // segments share their endpoints exactly
+    std::vector<Point> vertices;
+    vertices.reserve(segments);
+    for (int i = 0; i < segments; i++) {
+        double angle = (2.0 * M_PI * i) / segments;
+        vertices.push_back(Point(centerX + static_cast<int>(std::lround(r * std::cos(angle))),
+                                 centerY + static_cast<int>(std::lround(r * std::sin(angle)))));
+    }
+    
+    // Clip each chord to the city bounds by parameter range, the same
+    // vector form obstacle clipping uses, instead of filtering pixels
+    float minX = static_cast<float>(margin);
+    float minY = static_cast<float>(margin);
+    float maxX = static_cast<float>(worldWidth - margin);
+    float maxY = static_cast<float>(worldHeight - margin);
+    
+    for (int i = 0; i < segments; i++) {
+        const Point& a = vertices[i];
+        const Point& b = vertices[(i + 1) % segments];
+        if (a.x == b.x && a.y == b.y) continue;
+        
+        float tMin = 0.0f;
+        float tMax = 1.0f;
+        if (!clipSegmentToBox(a.x, a.y, b.x, b.y, minX, minY, maxX, maxY, tMin, tMax)) {
+            continue;
+        }
+        
+        Road road(a, b, width, tMin, tMax);
+        if (road.length() >= 1.0f) {
+            roads.push_back(road);
+        }
+    }
+}
+
 Road RoadGenerator::createRoad(int x0, int y0, int x1, int y1, int width) {
-    // Use Bresenham's Line Algorithm to generate pixel-perfect road
-    std::vector<Point> points = bresenhamLine(x0, y0, x1, y1);
-    return Road(points, width);
+    // Only the endpoints are stored; roads are never rasterized pixel by pixel
+    return Road(Point(x0, y0), Point(x1, y1), width);
 }
 
-Point RoadGenerator::randomPoint(int margin) {
-    std::uniform_int_distribution<int> xDist(margin, screenWidth - margin);
-    std::uniform_int_distribution<int> yDist(margin, screenHeight - margin);
+Point RoadGenerator::randomPoint(int inset) {
+    std::uniform_int_distribution<int> xDist(inset, worldWidth - inset);
+    std::uniform_int_distribution<int> yDist(inset, worldHeight - inset);
     
     return Point(xDist(rng), yDist(rng));
 }
 
-std::vector<Road> RoadGenerator::generateRoadsAvoidingObstacles(const CityConfig& config, 
-                                                                   const std::vector<std::vector<Point>>& parks,
-                                                                   const std::vector<Point>& fountain) {
-    // First generate all roads normally
-    std::vector<Road> allRoads = generateRoads(config);
+std::vector<Road> RoadGenerator::clipRoads(const std::vector<Road>& layout, int width,
+                                           const std::vector<Circle>& parks,
+                                           const Circle& fountain) {
     std::vector<Road> filteredRoads;
     
-    // Calculate centers and radii for all circles (parks and fountain)
-    struct Circle {
-        float centerX, centerY, radius;
-    };
+    // Collect all circles (parks and fountain)
     std::vector<Circle> circles;
-    
-    // Add parks as circles
     for (const auto& park : parks) {
-        if (park.empty()) continue;
-        
-        Circle circle;
-        circle.centerX = 0;
-        circle.centerY = 0;
-        for (const auto& point : park) {
-            circle.centerX += point.x;
-            circle.centerY += point.y;
-        }
-        circle.centerX /= park.size();
-        circle.centerY /= park.size();
-        
-        // Calculate radius
-        circle.radius = 0;
-        for (const auto& point : park) {
-            float dx = point.x - circle.centerX;
-            float dy = point.y - circle.centerY;
-            float dist = std::sqrt(dx * dx + dy * dy);
-            circle.radius = std::max(circle.radius, dist);
+        if (!park.empty()) {
+            circles.push_back(park);
         }
-        
-        circles.push_back(circle);
     }
-    
-    // Add fountain as a circle
     if (!fountain.empty()) {
-        Circle circle;
-        circle.centerX = 0;
-        circle.centerY = 0;
-        for (const auto& point : fountain) {
-            circle.centerX += point.x;
-            circle.centerY += point.y;
-        }
-        circle.centerX /= fountain.size();
-        circle.centerY /= fountain.size();
-        
-        // Calculate radius
-        circle.radius = 0;
-        for (const auto& point : fountain) {
-            float dx = point.x - circle.centerX;
-            float dy = point.y - circle.centerY;
-            float dist = std::sqrt(dx * dx + dy * dy);
-            circle.radius = std::max(circle.radius, dist);
-        }
-        
-        circles.push_back(circle);
+        circles.push_back(fountain);
     }
     
-    // Filter out road points that are inside any circle
-    int originalSegments = allRoads.size();
-    int totalPointsRemoved = 0;
+    // Clip every road segment against every circle analytically. Each road
+    // keeps a list of parameter intervals; every circle the road crosses
+    // cuts its inside interval out, splitting the road where necessary.
+    int originalSegments = layout.size();
+    int totalClips = 0;
     
-    for (const auto& road : allRoads) {
-        std::vector<Point> filteredPoints;
+    for (const auto& road : layout) {
+        std::vector<std::pair<float, float>> pieces(1, std::make_pair(road.tStart, road.tEnd));
         
-        for (const auto& roadPoint : road.points) {
-            bool insideCircle = false;
+        for (const auto& circle : circles) {
+            float tEnter, tExit;
+            if (!lineCircleInterval(road.start.x, road.start.y, road.end.x, road.end.y,
+                                    circle.centerX, circle.centerY, circle.radius,
+                                    tEnter, tExit)) {
+                continue;
+            }
             
-            // Check if road point is inside any circle
-            for (const auto& circle : circles) {
-                float dx = roadPoint.x - circle.centerX;
-                float dy = roadPoint.y - circle.centerY;
-                float distanceSquared = dx * dx + dy * dy;
-                float radiusSquared = circle.radius * circle.radius;
+            std::vector<std::pair<float, float>> remaining;
+            for (const auto& piece : pieces) {
+                if (tExit <= piece.first || tEnter >= piece.second) {
+                    remaining.push_back(piece);  // Circle misses this piece
+                    continue;
+                }
                 
-                // If point is inside circle, mark it for removal
-                if (distanceSquared <= radiusSquared) {
-                    insideCircle = true;
-                    totalPointsRemoved++;
-                    break;
+                totalClips++;
+                if (tEnter > piece.first) {
+                    remaining.push_back(std::make_pair(piece.first, tEnter));
+                }
+                if (tExit < piece.second) {
+                    remaining.push_back(std::make_pair(tExit, piece.second));
                 }
             }
-            
-            // Only add road point if it's outside all circles
-            if (!insideCircle) {
-                filteredPoints.push_back(roadPoint);
-            }
+            pieces.swap(remaining);
         }
         
-        // Only add road if it has at least some points remaining
-        if (!filteredPoints.empty()) {
-            filteredRoads.push_back(Road(filteredPoints, road.width));
+        // Emit each surviving piece as its own road, dropping slivers shorter
+        // than a pixel that would not survive rasterization anyway
+        for (const auto& piece : pieces) {
+            Road clipped(road.start, road.end, width, piece.first, piece.second);
+            if (clipped.length() >= 1.0f) {
+                filteredRoads.push_back(clipped);
+            }
         }
     }
     
-    std::cout << "   - Removed " << totalPointsRemoved << " road points inside circles\n";
+    std::cout << "   - Clipped " << totalClips << " road pieces against circles\n";
     std::cout << "   - Filtered roads: " << originalSegments << " → " << filteredRoads.size() << " segments\n";
     
     return filteredRoads;
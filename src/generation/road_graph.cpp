@@ -0,0 +1,336 @@
+#include "generation/road_graph.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <set>
+#include <unordered_map>
+
+// Tolerances in world units. Sweep comparisons are done in double
+// precision; points closer than NODE_SNAP are treated as one node, which
+// absorbs the rounding of intersection points computed from different
+// pairs of roads through the same junction.
+static const double SWEEP_EPSILON = 1e-5;
+static const double NODE_SNAP = 1e-3;
+
+namespace {
+
+struct SweepPoint {
+    double x, y;
+};
+
+// Events are processed left to right, bottom to top on ties
+struct SweepPointLess {
+    bool operator()(const SweepPoint& a, const SweepPoint& b) const {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    }
+};
+
+// A road's kept interval, oriented so (x0, y0) is the first event
+struct SweepSegment {
+    double x0, y0, x1, y1;
+    double slope;       // +infinity for vertical segments
+    int road;
+    bool flipped;       // Whether (x0, y0) is the road's tEnd end
+};
+
+struct Sweep {
+    std::vector<SweepSegment> segments;
+    double px, py;      // Current event point
+
+    // Height of a segment on the sweep line. Vertical segments sit at the
+    // event point itself, which is the only place the sweep meets them.
+    double yAt(int s) const {
+        if (s < 0) return py;  // The probe used to search around the event point
+        const SweepSegment& seg = segments[s];
+        if (seg.x0 == seg.x1) return std::min(std::max(py, seg.y0), seg.y1);
+        if (px == seg.x0) return seg.y0;
+        if (px == seg.x1) return seg.y1;
+        return seg.y0 + (px - seg.x0) * seg.slope;
+    }
+
+    double slopeOf(int s) const {
+        return s < 0 ? -std::numeric_limits<double>::infinity() : segments[s].slope;
+    }
+};
+
+// Status order: by height on the sweep line, and for segments meeting at
+// the event point, by slope, which is their order just past the event
+struct StatusLess {
+    const Sweep* sweep;
+
+    bool operator()(int a, int b) const {
+        double ya = sweep->yAt(a);
+        double yb = sweep->yAt(b);
+        if (std::fabs(ya - yb) > SWEEP_EPSILON) return ya < yb;
+
+        double sa = sweep->slopeOf(a);
+        double sb = sweep->slopeOf(b);
+        if (sa != sb) return sa < sb;
+        return a < b;
+    }
+};
+
+// Intersection of two segments, including touching ends. Parallel
+// segments report none; where they overlap their shared ends still become
+// nodes through the endpoint events.
+bool segmentIntersection(const SweepSegment& a, const SweepSegment& b, SweepPoint& out) {
+    double ax = a.x1 - a.x0, ay = a.y1 - a.y0;
+    double bx = b.x1 - b.x0, by = b.y1 - b.y0;
+    double denom = ax * by - ay * bx;
+    double scale = std::sqrt((ax * ax + ay * ay) * (bx * bx + by * by));
+    if (std::fabs(denom) <= 1e-12 * scale) return false;
+
+    double wx = b.x0 - a.x0, wy = b.y0 - a.y0;
+    double t = (wx * by - wy * bx) / denom;
+    double u = (wx * ay - wy * ax) / denom;
+    const double tolerance = 1e-9;
+    if (t < -tolerance || t > 1.0 + tolerance || u < -tolerance || u > 1.0 + tolerance) {
+        return false;
+    }
+
+    t = std::min(std::max(t, 0.0), 1.0);
+    out.x = a.x0 + t * ax;
+    out.y = a.y0 + t * ay;
+    return true;
+}
+
+} // namespace
+
+RoadGraph::RoadGraph() : componentTotal(0), crossingTotal(0) {
+}
+
+void RoadGraph::clear() {
+    nodes.clear();
+    edges.clear();
+    component.clear();
+    componentTotal = 0;
+    crossingTotal = 0;
+}
+
+void RoadGraph::build(const std::vector<Road>& roads) {
+    clear();
+
+    Sweep sweep;
+    sweep.px = sweep.py = 0.0;
+    sweep.segments.reserve(roads.size());
+
+    std::map<SweepPoint, std::vector<int>, SweepPointLess> events;  // Point -> segments starting there
+
+    for (size_t i = 0; i < roads.size(); i++) {
+        const Road& road = roads[i];
+        SweepPoint a = { road.x0(), road.y0() };
+        SweepPoint b = { road.x1(), road.y1() };
+        if (a.x == b.x && a.y == b.y) continue;  // Nothing to connect
+
+        bool flipped = SweepPointLess()(b, a);
+        if (flipped) std::swap(a, b);
+
+        SweepSegment seg;
+        seg.x0 = a.x; seg.y0 = a.y;
+        seg.x1 = b.x; seg.y1 = b.y;
+        seg.slope = (a.x == b.x) ? std::numeric_limits<double>::infinity()
+                                 : (b.y - a.y) / (b.x - a.x);
+        seg.road = static_cast<int>(i);
+        seg.flipped = flipped;
+
+        events[a].push_back(static_cast<int>(sweep.segments.size()));
+        events[b];  // Right ends are events too, with nothing starting there
+        sweep.segments.push_back(seg);
+    }
+
+    size_t segmentCount = sweep.segments.size();
+    std::set<int, StatusLess> status(StatusLess{ &sweep });
+    std::vector<std::set<int, StatusLess>::iterator> position(segmentCount, status.end());
+
+    // Nodes met along each segment, as (parameter along the road, node)
+    std::vector<std::vector<std::pair<float, int>>> stops(segmentCount);
+    std::vector<bool> isCrossing;
+
+    // Nodes are bucketed by NODE_SNAP cells so near-identical points merge
+    std::unordered_map<uint64_t, int> nodeCells;
+    auto cellKey = [](int64_t cx, int64_t cy) {
+        return (static_cast<uint64_t>(cx) << 32) ^ static_cast<uint32_t>(cy);
+    };
+    auto nodeAt = [&](double x, double y) {
+        int64_t cx = static_cast<int64_t>(std::floor(x / NODE_SNAP));
+        int64_t cy = static_cast<int64_t>(std::floor(y / NODE_SNAP));
+        for (int64_t dx = -1; dx <= 1; dx++) {
+            for (int64_t dy = -1; dy <= 1; dy++) {
+                auto it = nodeCells.find(cellKey(cx + dx, cy + dy));
+                if (it == nodeCells.end()) continue;
+                const RoadNode& node = nodes[it->second];
+                if (std::fabs(node.x - x) <= NODE_SNAP && std::fabs(node.y - y) <= NODE_SNAP) {
+                    return it->second;
+                }
+            }
+        }
+        int id = static_cast<int>(nodes.size());
+        nodes.emplace_back(static_cast<float>(x), static_cast<float>(y));
+        isCrossing.push_back(false);
+        nodeCells.emplace(cellKey(cx, cy), id);
+        return id;
+    };
+
+    // Parameter of a point along the road a segment came from
+    auto roadParameter = [&](int s, double x, double y) {
+        const SweepSegment& seg = sweep.segments[s];
+        double dx = seg.x1 - seg.x0, dy = seg.y1 - seg.y0;
+        double along = ((x - seg.x0) * dx + (y - seg.y0) * dy) / (dx * dx + dy * dy);
+        along = std::min(std::max(along, 0.0), 1.0);
+        const Road& road = roads[seg.road];
+        double t = seg.flipped ? 1.0 - along : along;
+        return static_cast<float>(road.tStart + t * (road.tEnd - road.tStart));
+    };
+
+    // Queue the meeting point of two status neighbours if it lies ahead
+    auto checkPair = [&](int a, int b) {
+        SweepPoint hit;
+        if (!segmentIntersection(sweep.segments[a], sweep.segments[b], hit)) return;
+        SweepPoint current = { sweep.px, sweep.py };
+        if (SweepPointLess()(current, hit)) {
+            events[hit];
+        }
+    };
+
+    std::vector<int> through;
+    std::vector<int> reinsert;
+
+    while (!events.empty()) {
+        auto event = events.begin();
+        SweepPoint p = event->first;
+        std::vector<int> starting = std::move(event->second);
+        events.erase(event);
+
+        sweep.px = p.x;
+        sweep.py = p.y;
+
+        // Segments already in the status that pass through or end at p
+        through.clear();
+        for (auto it = status.lower_bound(-1);
+             it != status.end() && std::fabs(sweep.yAt(*it) - p.y) <= SWEEP_EPSILON; ++it) {
+            through.push_back(*it);
+        }
+
+        bool anyEnding = false;
+        bool anyInterior = false;
+        for (int s : through) {
+            const SweepSegment& seg = sweep.segments[s];
+            if (seg.x1 == p.x && seg.y1 == p.y) anyEnding = true;
+            else anyInterior = true;
+        }
+
+        // Every road end is a node; otherwise a node needs two roads meeting
+        if (!starting.empty() || anyEnding || through.size() >= 2) {
+            int node = nodeAt(p.x, p.y);
+            if (anyInterior && through.size() + starting.size() >= 2) {
+                isCrossing[node] = true;
+            }
+            for (int s : through) stops[s].emplace_back(roadParameter(s, p.x, p.y), node);
+            for (int s : starting) stops[s].emplace_back(roadParameter(s, p.x, p.y), node);
+        }
+
+        // Re-insert everything continuing past p in its order just after p
+        reinsert.clear();
+        for (int s : through) {
+            status.erase(position[s]);
+            position[s] = status.end();
+            const SweepSegment& seg = sweep.segments[s];
+            if (!(seg.x1 == p.x && seg.y1 == p.y)) reinsert.push_back(s);
+        }
+        reinsert.insert(reinsert.end(), starting.begin(), starting.end());
+        for (int s : reinsert) {
+            position[s] = status.insert(s).first;
+        }
+
+        // Only new neighbours can produce new meeting points
+        if (reinsert.empty()) {
+            auto above = status.lower_bound(-1);
+            if (above != status.end() && above != status.begin()) {
+                checkPair(*std::prev(above), *above);
+            }
+            continue;
+        }
+
+        auto first = position[reinsert.front()];
+        auto last = first;
+        for (int s : reinsert) {
+            if (status.key_comp()(s, *first)) first = position[s];
+            if (status.key_comp()(*last, s)) last = position[s];
+        }
+        if (first != status.begin()) {
+            checkPair(*std::prev(first), *first);
+        }
+        auto after = std::next(last);
+        if (after != status.end()) {
+            checkPair(*last, *after);
+        }
+    }
+
+    // Split every road into edges between consecutive nodes along it
+    for (size_t s = 0; s < segmentCount; s++) {
+        auto& along = stops[s];
+        std::sort(along.begin(), along.end());
+
+        int road = sweep.segments[s].road;
+        for (size_t i = 1; i < along.size(); i++) {
+            int from = along[i - 1].second;
+            int to = along[i].second;
+            if (from == to) continue;
+
+            int id = static_cast<int>(edges.size());
+            edges.emplace_back(from, to, road, along[i - 1].first, along[i].first);
+            nodes[from].edges.push_back(id);
+            nodes[to].edges.push_back(id);
+        }
+    }
+
+    crossingTotal = static_cast<int>(std::count(isCrossing.begin(), isCrossing.end(), true));
+
+    // Label connected components with union-find over the edges
+    std::vector<int> parent(nodes.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&](int n) {
+        while (parent[n] != n) {
+            parent[n] = parent[parent[n]];
+            n = parent[n];
+        }
+        return n;
+    };
+    for (const auto& edge : edges) {
+        parent[find(edge.from)] = find(edge.to);
+    }
+
+    component.assign(nodes.size(), -1);
+    std::vector<int> label(nodes.size(), -1);
+    for (size_t n = 0; n < nodes.size(); n++) {
+        int root = find(static_cast<int>(n));
+        if (label[root] < 0) label[root] = componentTotal++;
+        component[n] = label[root];
+    }
+}
+
+bool RoadGraph::connected(int nodeA, int nodeB) const {
+    if (nodeA < 0 || nodeB < 0 ||
+        nodeA >= static_cast<int>(nodes.size()) || nodeB >= static_cast<int>(nodes.size())) {
+        return false;
+    }
+    return component[nodeA] == component[nodeB];
+}
+
+int RoadGraph::nearestNode(float x, float y) const {
+    int best = -1;
+    float bestDistance = 0.0f;
+    for (size_t n = 0; n < nodes.size(); n++) {
+        float dx = nodes[n].x - x;
+        float dy = nodes[n].y - y;
+        float distance = dx * dx + dy * dy;
+        if (best < 0 || distance < bestDistance) {
+            best = static_cast<int>(n);
+            bestDistance = distance;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,70 @@
+#include "generation/spatial_grid.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid() : cellSize(64.0f), cols(1), rows(1), cells(1) {
+}
+
+void SpatialGrid::reset(int width, int height, float size) {
+    cellSize = size;
+    cols = std::max(1, static_cast<int>(std::ceil(width / cellSize)));
+    rows = std::max(1, static_cast<int>(std::ceil(height / cellSize)));
+
+    cells.clear();
+    cells.resize(cols * rows);
+}
+
+void SpatialGrid::insert(const GridEntry& entry, float minX, float minY, float maxX, float maxY) {
+    int c0, r0, c1, r1;
+    cellRange(minX, minY, maxX, maxY, c0, r0, c1, r1);
+
+    for (int r = r0; r <= r1; r++) {
+        for (int c = c0; c <= c1; c++) {
+            cells[r * cols + c].push_back(entry);
+        }
+    }
+}
+
+void SpatialGrid::insertSegment(const GridEntry& entry, float x0, float y0, float x1, float y1, float radius) {
+    int c0, r0, c1, r1;
+    cellRange(std::min(x0, x1) - radius, std::min(y0, y1) - radius,
+              std::max(x0, x1) + radius, std::max(y0, y1) + radius, c0, r0, c1, r1);
+
+    float dy = y1 - y0;
+
+    for (int r = r0; r <= r1; r++) {
+        // Portion of the segment whose thick band reaches this row of cells
+        float bandTop = r * cellSize - radius;
+        float bandBottom = (r + 1) * cellSize + radius;
+
+        float tMin = 0.0f;
+        float tMax = 1.0f;
+        if (dy != 0.0f) {
+            float tA = (bandTop - y0) / dy;
+            float tB = (bandBottom - y0) / dy;
+            tMin = std::max(tMin, std::min(tA, tB));
+            tMax = std::min(tMax, std::max(tA, tB));
+        }
+        if (tMin > tMax) continue;
+
+        float xa = x0 + (x1 - x0) * tMin;
+        float xb = x0 + (x1 - x0) * tMax;
+
+        int rowC0, rowR0, rowC1, rowR1;
+        cellRange(std::min(xa, xb) - radius, 0.0f, std::max(xa, xb) + radius, 0.0f,
+                  rowC0, rowR0, rowC1, rowR1);
+
+        for (int c = std::max(c0, rowC0); c <= std::min(c1, rowC1); c++) {
+            cells[r * cols + c].push_back(entry);
+        }
+    }
+}
+
+void SpatialGrid::cellRange(float minX, float minY, float maxX, float maxY,
+                            int& c0, int& r0, int& c1, int& r1) const {
+    // Elements outside the covered area are clamped into the border cells
+    c0 = std::max(0, std::min(cols - 1, static_cast<int>(std::floor(minX / cellSize))));
+    r0 = std::max(0, std::min(rows - 1, static_cast<int>(std::floor(minY / cellSize))));
+    c1 = std::max(0, std::min(cols - 1, static_cast<int>(std::floor(maxX / cellSize))));
+    r1 = std::max(0, std::min(rows - 1, static_cast<int>(std::floor(maxY / cellSize))));
+}
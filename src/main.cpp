@@ -1,6 +1,7 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <iostream>
+#include <string>
 #include <vector>
 #include <cmath>
 #include <glm/glm.hpp>
@@ -14,24 +15,26 @@
 #include "core/city_config.h"
 #include "utils/algorithms.h"
 #include "utils/input_handler.h"
-#include "generation/city_generator.h"
+#include "generation/generation_worker.h"
 #include "rendering/texture_manager.h"
 #include "rendering/shaders/shader_manager.h"
 #include "rendering/camera.h"
 #include "rendering/city_renderer.h"
+#include "rendering/mesh/road_mesh.h"
 
 int main()
 {
     // Window dimensions
     const int SCREEN_WIDTH = 800;
     const int SCREEN_HEIGHT = 600;
+    const std::string WINDOW_TITLE = "City Designer - Interactive Mode";
     
     // Create city configuration with default values
     CityConfig cityConfig;
     InputHandler inputHandler(cityConfig);
     
-    // Create city generator
-    CityGenerator cityGenerator(SCREEN_WIDTH, SCREEN_HEIGHT);
+    // Cities are generated on a worker thread and streamed to the renderer
+    GenerationWorker generationWorker;
     
     // Display welcome message and controls
     std::cout << "\n";
@@ -42,8 +45,12 @@ int main()
     InputHandler::displayControls();
     cityConfig.printConfig();
     
+#ifdef CHECK_ROAD_COVERAGE
+    checkRoadJoins();
+#endif
+    
     // Initialize application (GLFW + OpenGL context)
-    Application app(SCREEN_WIDTH, SCREEN_HEIGHT, "City Designer - Interactive Mode");
+    Application app(SCREEN_WIDTH, SCREEN_HEIGHT, WINDOW_TITLE);
     if (!app.isValid()) {
         return -1;
     }
@@ -63,7 +70,10 @@ int main()
     }
     
     // Create renderer
-    CityRenderer renderer(SCREEN_WIDTH, SCREEN_HEIGHT);
+    int framebufferWidth, framebufferHeight;
+    app.getFramebufferSize(framebufferWidth, framebufferHeight);
+    CityRenderer renderer(framebufferWidth, framebufferHeight);
+    renderer.setViewMode(cityConfig.view3D);
 
     // ----- Shader Compilation (Using ShaderManager) -----
     ShaderManager shaderManager;
@@ -90,8 +100,8 @@ int main()
     GLuint grassTexture = textureManager.getTexture("grass");
     GLuint fountainTexture = textureManager.getTexture("fountain");
 
-    // Connect input handler to city generator
-    inputHandler.setCityGenerator(&cityGenerator);
+    // Connect input handler to the generation worker
+    inputHandler.setGenerationWorker(&generationWorker);
 
     std::cout << "\n✅ OpenGL initialized successfully!\n";
     std::cout << "Press 'G' to generate a city, or adjust parameters first.\n\n";
@@ -99,6 +109,9 @@ int main()
     // Track view mode changes
     bool lastView3D = cityConfig.view3D;
     
+    // Generation progress shown in the title bar (-1 when idle)
+    int shownPercent = -1;
+    
     // ----- Render Loop -----
     while (!app.shouldClose())
     {
@@ -123,14 +136,25 @@ int main()
             }
         }
         
-        // If city was generated OR view mode changed, update rendering data
-        if (inputHandler.generationRequested() || viewModeChanged) {
-            inputHandler.clearGenerationRequest();
-            
-            if (cityGenerator.hasCity()) {
-                const CityData& city = cityGenerator.getCityData();
-                renderer.updateCity(city, cityConfig.view3D);
-            }
+        // A new view mode rebuilds every mesh; otherwise the renderer
+        // appends whatever part of the city was generated since last frame
+        if (viewModeChanged) {
+            renderer.setViewMode(cityConfig.view3D);
+        }
+        
+        // 2D roads are a fixed number of pixels wide, so they follow resizes
+        app.getFramebufferSize(framebufferWidth, framebufferHeight);
+        renderer.setFramebufferSize(framebufferWidth, framebufferHeight);
+        
+        renderer.consumeStream(generationWorker.getStream());
+        
+        // Show progress while the worker is busy
+        int percent = generationWorker.isBusy()
+            ? static_cast<int>(generationWorker.getProgress() * 100.0f) : -1;
+        if (percent != shownPercent) {
+            shownPercent = percent;
+            app.setTitle(percent < 0 ? WINDOW_TITLE
+                                     : WINDOW_TITLE + " - Generating " + std::to_string(percent) + "%");
         }
         
         // Dark background (like a city at dusk)
@@ -157,9 +181,8 @@ int main()
         shaderManager.setProjection(glm::value_ptr(projection));
 
         // Render the city if generated
-        if (cityGenerator.hasCity() && renderer.isReady()) {
-            const CityData& city = cityGenerator.getCityData();
-            renderer.render(city, cityConfig, cityConfig.view3D, shaderManager,
+        if (renderer.isReady()) {
+            renderer.render(cityConfig, cityConfig.view3D, shaderManager,
                           brickTexture, concreteTexture, glassTexture,
                           roadTexture, grassTexture, fountainTexture);
         }
@@ -168,6 +191,7 @@ int main()
     }
     
     // Cleanup - All resources automatically cleaned up by destructors:
+    // - GenerationWorker cancels and joins its thread
     // - Application handles GLFW termination
     // - CityRenderer handles VAO/VBO cleanup
     // - TextureManager handles texture cleanup
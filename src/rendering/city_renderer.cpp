@@ -7,18 +7,29 @@
  */
 
 #include "rendering/city_renderer.h"
-#include "rendering/mesh/building_mesh.h"
 #include "rendering/mesh/road_mesh.h"
 #include "rendering/mesh/park_mesh.h"
 #include "rendering/mesh/mesh_utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+
+// Time per frame spent meshing streamed batches. Whatever is left over
+// waits for the next frame, so the render loop stays responsive.
+static const std::chrono::microseconds STREAM_BUDGET(4000);
+
+// Smallest buffer a group allocates, in vertices
+static const GLsizei MIN_GROUP_CAPACITY = 4096;
 
 // Constructor
-CityRenderer::CityRenderer(int screenWidth, int screenHeight)
-    : screenWidth(screenWidth)
-    , screenHeight(screenHeight)
-    , fountain3DVAO(0)
-    , fountain3DVBO(0)
-    , fountain3DVertexCount(0)
+CityRenderer::CityRenderer(int framebufferWidth, int framebufferHeight)
+    : roads2D(false), parks2D(false), fountain2D(false),
+      roads3D(true), parks3D(true), fountain3D(true),
+      buildingVAO(0), buildingMeshVBO(0), buildingIndexBuffer(0), buildingInstanceVBO(0),
+      instanceCapacity(0), instanceCount(0), incomingCursor(0), meshView3D(false), ready(false),
+      roadsJoined(false), framebufferWidth(std::max(1, framebufferWidth)),
+      framebufferHeight(std::max(1, framebufferHeight))
 {
 }
 
@@ -29,55 +40,94 @@ CityRenderer::~CityRenderer() {
 
 // Cleanup all buffers
 void CityRenderer::cleanup() {
-    // Cleanup 2D buffers
-    if (!VAOs.empty()) {
-        glDeleteVertexArrays(VAOs.size(), VAOs.data());
-        glDeleteBuffers(VBOs.size(), VBOs.data());
-        VAOs.clear();
-        VBOs.clear();
-        vertexCounts.clear();
-    }
+    releaseGroup(roads2D);
+    releaseGroup(parks2D);
+    releaseGroup(fountain2D);
+    releaseGroup(roads3D);
+    releaseGroup(parks3D);
+    releaseGroup(fountain3D);
     
-    // Cleanup 3D road buffers
-    if (!road3DVAOs.empty()) {
-        glDeleteVertexArrays(road3DVAOs.size(), road3DVAOs.data());
-        glDeleteBuffers(road3DVBOs.size(), road3DVBOs.data());
-        road3DVAOs.clear();
-        road3DVBOs.clear();
-        road3DVertexCounts.clear();
+    if (buildingVAO != 0) {
+        GLuint buffers[] = { buildingMeshVBO, buildingIndexBuffer, buildingInstanceVBO };
+        glDeleteVertexArrays(1, &buildingVAO);
+        glDeleteBuffers(buildingInstanceVBO != 0 ? 3 : 2, buffers);
     }
-    
-    // Cleanup 3D park buffers
-    if (!park3DVAOs.empty()) {
-        glDeleteVertexArrays(park3DVAOs.size(), park3DVAOs.data());
-        glDeleteBuffers(park3DVBOs.size(), park3DVBOs.data());
-        park3DVAOs.clear();
-        park3DVBOs.clear();
-        park3DVertexCounts.clear();
+    buildingVAO = 0;
+    buildingMeshVBO = 0;
+    buildingIndexBuffer = 0;
+    buildingInstanceVBO = 0;
+    instanceCapacity = 0;
+    clearBuildings();
+    ready = false;
+}
+
+// Empty a group, keeping its buffer
+void CityRenderer::clearGroup(MeshGroup& group) {
+    group.vertexCount = 0;
+    group.firsts.clear();
+    group.counts.clear();
+}
+
+// Delete the buffer of one group
+void CityRenderer::releaseGroup(MeshGroup& group) {
+    if (group.VAO != 0) {
+        glDeleteVertexArrays(1, &group.VAO);
+        glDeleteBuffers(1, &group.VBO);
     }
+    group.VAO = 0;
+    group.VBO = 0;
+    group.capacity = 0;
+    clearGroup(group);
+}
+
+// Append a mesh to a group
+GLint CityRenderer::addMesh(MeshGroup& group, const std::vector<float>& vertices) {
+    int floatsPerVertex = group.hasTexCoords ? 5 : 3;
+    GLsizei count = static_cast<GLsizei>(vertices.size() / floatsPerVertex);
+    GLint first = group.vertexCount;
     
-    // Cleanup 3D fountain buffer
-    if (fountain3DVAO != 0) {
-        glDeleteVertexArrays(1, &fountain3DVAO);
-        glDeleteBuffers(1, &fountain3DVBO);
-        fountain3DVAO = 0;
-        fountain3DVBO = 0;
-        fountain3DVertexCount = 0;
+    if (count > 0) {
+        reserveVertices(group, first + count);
+        glBindBuffer(GL_ARRAY_BUFFER, group.VBO);
+        glBufferSubData(GL_ARRAY_BUFFER, first * floatsPerVertex * sizeof(float),
+                        count * floatsPerVertex * sizeof(float), vertices.data());
     }
+    
+    group.firsts.push_back(first);
+    group.counts.push_back(count);
+    group.vertexCount += count;
+    return first;
 }
 
-// Create buffer for mesh
-std::pair<GLuint, GLuint> CityRenderer::createBuffer(const std::vector<float>& vertices, bool hasTexCoords) {
-    GLuint VAO, VBO;
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
+// Grow the buffer of a group
+void CityRenderer::reserveVertices(MeshGroup& group, GLsizei needed) {
+    if (needed <= group.capacity) return;
+    
+    GLsizei capacity = std::max(std::max(needed, MIN_GROUP_CAPACITY), 2 * group.capacity);
+    GLsizeiptr stride = (group.hasTexCoords ? 5 : 3) * sizeof(float);
     
-    glBindVertexArray(VAO);
+    GLuint VBO;
+    glGenBuffers(1, &VBO);
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), 
-                vertices.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, capacity * stride, nullptr, GL_STATIC_DRAW);
+    
+    // Carry the meshes over without a round trip through the CPU
+    if (group.VBO != 0) {
+        if (group.vertexCount > 0) {
+            glBindBuffer(GL_COPY_READ_BUFFER, group.VBO);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_ARRAY_BUFFER, 0, 0, group.vertexCount * stride);
+        }
+        glDeleteBuffers(1, &group.VBO);
+    }
+    group.VBO = VBO;
+    group.capacity = capacity;
+    
+    if (group.VAO == 0) {
+        glGenVertexArrays(1, &group.VAO);
+    }
+    glBindVertexArray(group.VAO);
     
-    if (hasTexCoords) {
+    if (group.hasTexCoords) {
         // Position attribute (location = 0)
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
         glEnableVertexAttribArray(0);
@@ -91,114 +141,314 @@ std::pair<GLuint, GLuint> CityRenderer::createBuffer(const std::vector<float>& v
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
         glEnableVertexAttribArray(0);
     }
+}
+
+// Create the building VAO
+void CityRenderer::createBuildingMesh() {
+    glGenVertexArrays(1, &buildingVAO);
+    glGenBuffers(1, &buildingMeshVBO);
+    glGenBuffers(1, &buildingIndexBuffer);
+    
+    glBindVertexArray(buildingVAO);
+    
+    // The element buffer binding is part of the VAO's state
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buildingIndexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(BUILDING_INDICES), BUILDING_INDICES, GL_STATIC_DRAW);
+    
+    uploadBuildingMesh();
+    
+    // Position attribute (location = 0)
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
     
-    return {VAO, VBO};
+    // Texture coordinate attribute (location = 1)
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), 
+                         (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
 }
 
-// Update city rendering data
-void CityRenderer::updateCity(const CityData& city, bool view3D) {
-    // Cleanup old buffers
-    cleanup();
+// Upload the unit box for the current view mode
+void CityRenderer::uploadBuildingMesh() {
+    std::vector<float> vertices = unitBuildingVertices(meshView3D);
+    glBindBuffer(GL_ARRAY_BUFFER, buildingMeshVBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+}
+
+// Grow the building instance buffer
+void CityRenderer::reserveInstances(GLsizei needed) {
+    if (needed <= instanceCapacity) return;
+    
+    GLsizei capacity = std::max(std::max(needed, MIN_GROUP_CAPACITY), 2 * instanceCapacity);
+    
+    GLuint VBO;
+    glGenBuffers(1, &VBO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(BuildingInstance), nullptr, GL_DYNAMIC_DRAW);
     
-    // Create buffers for roads (2D points)
-    for (const auto& road : city.roads) {
-        auto vertices = pointsToVertices(road.points, screenWidth, screenHeight);
-        auto [vao, vbo] = createBuffer(vertices, false);
-        VAOs.push_back(vao);
-        VBOs.push_back(vbo);
-        vertexCounts.push_back(vertices.size() / 3);
+    // Carry the records over without a round trip through the CPU
+    if (buildingInstanceVBO != 0) {
+        if (instanceCount > 0) {
+            glBindBuffer(GL_COPY_READ_BUFFER, buildingInstanceVBO);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_ARRAY_BUFFER, 0, 0,
+                                instanceCount * sizeof(BuildingInstance));
+        }
+        glDeleteBuffers(1, &buildingInstanceVBO);
     }
+    buildingInstanceVBO = VBO;
+    instanceCapacity = capacity;
     
-    // Create 3D textured road meshes
-    for (const auto& road : city.roads) {
-        auto vertices = roadTo3DMesh(road, screenWidth, screenHeight, view3D);
-        if (!vertices.empty()) {
-            auto [vao, vbo] = createBuffer(vertices, true);
-            road3DVAOs.push_back(vao);
-            road3DVBOs.push_back(vbo);
-            road3DVertexCounts.push_back(vertices.size() / 5);
+    // Per-instance attributes advance once per building instead of per vertex
+    glBindVertexArray(buildingVAO);
+    const GLsizei stride = sizeof(BuildingInstance);
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(BuildingInstance, offset));
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(BuildingInstance, scale));
+    glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
+    glVertexAttribIPointer(4, 1, GL_INT, stride, (void*)offsetof(BuildingInstance, material));
+    glEnableVertexAttribArray(4);
+    glVertexAttribDivisor(4, 1);
+}
+
+// Append building instances
+void CityRenderer::addInstances(const std::vector<BuildingInstance>& instances) {
+    if (instances.empty()) return;
+    if (buildingVAO == 0) {
+        createBuildingMesh();
+    }
+    
+    GLsizei count = static_cast<GLsizei>(instances.size());
+    reserveInstances(instanceCount + count);
+    glBindBuffer(GL_ARRAY_BUFFER, buildingInstanceVBO);
+    glBufferSubData(GL_ARRAY_BUFFER, instanceCount * sizeof(BuildingInstance),
+                    count * sizeof(BuildingInstance), instances.data());
+    instanceCount += count;
+}
+
+// Receive and mesh streamed batches
+void CityRenderer::consumeStream(CityStream& stream) {
+    CityBatch batch;
+    while (stream.receive(batch)) {
+        incoming.push_back(std::move(batch));
+    }
+    
+    auto deadline = std::chrono::steady_clock::now() + STREAM_BUDGET;
+    while (!incoming.empty()) {
+        if (!applyBatch(deadline)) break;
+    }
+}
+
+// Apply the oldest waiting batch
+bool CityRenderer::applyBatch(std::chrono::steady_clock::time_point deadline) {
+    CityBatch& batch = incoming.front();
+    shown.world = batch.world;
+    ready = true;
+    
+    // Roads and buildings are meshed one at a time, stopping when the
+    // frame's time is up; incomingCursor remembers where to carry on
+    if (incomingCursor == 0 && batch.restart) {
+        switch (batch.kind) {
+            case CityBatchKind::ROADS:
+                clearGroup(roads2D);
+                clearGroup(roads3D);
+                shown.roads.clear();
+                shown.roadGraph.clear();
+                roadsJoined = false;
+                break;
+            case CityBatchKind::BUILDINGS:
+                clearBuildings();
+                shown.buildings.clear();
+                break;
+            case CityBatchKind::PARKS:
+                break;
         }
     }
     
+    switch (batch.kind) {
+        case CityBatchKind::PARKS:
+            shown.parks = std::move(batch.parks);
+            shown.fountain = batch.fountain;
+            meshParks();
+            break;
+            
+        case CityBatchKind::ROADS:
+            while (incomingCursor < batch.roads.size()) {
+                if (std::chrono::steady_clock::now() >= deadline) return false;
+                shown.roads.push_back(batch.roads[incomingCursor++]);
+                meshRoad(shown.roads.back());
+            }
+            if (batch.lastRoads) {
+                shown.roadGraph = std::move(batch.roadGraph);
+                roadsJoined = true;
+                joinRoads();
+            }
+            break;
+            
+        case CityBatchKind::BUILDINGS: {
+            // Records are gathered first and uploaded in one go
+            bool finished = true;
+            instanceScratch.clear();
+            while (incomingCursor < batch.buildings.size()) {
+                if (std::chrono::steady_clock::now() >= deadline) {
+                    finished = false;
+                    break;
+                }
+                shown.buildings.push_back(batch.buildings[incomingCursor++]);
+                instanceScratch.push_back(buildingToInstance(shown.buildings.back(), shown.world, meshView3D));
+            }
+            addInstances(instanceScratch);
+            if (!finished) return false;
+            break;
+        }
+    }
+    
+    incoming.pop_front();
+    incomingCursor = 0;
+    return std::chrono::steady_clock::now() < deadline;
+}
+
+// Switch view mode
+void CityRenderer::setViewMode(bool view3D) {
+    if (view3D == meshView3D) return;
+    meshView3D = view3D;
+    rebuild();
+}
+
+// Follow framebuffer resizes
+void CityRenderer::setFramebufferSize(int width, int height) {
+    if (width <= 0 || height <= 0) return;
+    if (width == framebufferWidth && height == framebufferHeight) return;
+    framebufferWidth = width;
+    framebufferHeight = height;
+    meshRoadLines();
+}
+
+// Rebuild all buffers from the shown city
+void CityRenderer::rebuild() {
+    clearGroup(roads2D);
+    clearGroup(roads3D);
+    clearBuildings();
+    
+    meshParks();
+    if (roadsJoined) {
+        // The joined network replaces the 3D quads; only the lines are per road
+        meshRoadLines();
+        joinRoads();
+    } else {
+        for (const auto& road : shown.roads) {
+            meshRoad(road);
+        }
+    }
+    
+    if (buildingVAO != 0) {
+        uploadBuildingMesh();
+    }
+    instanceScratch.clear();
+    for (const auto& building : shown.buildings) {
+        instanceScratch.push_back(buildingToInstance(building, shown.world, meshView3D));
+    }
+    addInstances(instanceScratch);
+}
+
+// Rebuild park and fountain buffers
+void CityRenderer::meshParks() {
+    clearGroup(parks2D);
+    clearGroup(parks3D);
+    clearGroup(fountain2D);
+    clearGroup(fountain3D);
+    
     // Create buffers for parks (2D points)
-    for (const auto& park : city.parks) {
-        auto vertices = pointsToVertices(park, screenWidth, screenHeight);
-        auto [vao, vbo] = createBuffer(vertices, false);
-        VAOs.push_back(vao);
-        VBOs.push_back(vbo);
-        vertexCounts.push_back(vertices.size() / 3);
+    for (const auto& park : shown.parks) {
+        addMesh(parks2D, pointsToVertices(park.perimeter(), shown.world));
     }
     
     // Create 3D textured park meshes
-    for (const auto& park : city.parks) {
-        auto vertices = parkTo3DMesh(park, screenWidth, screenHeight, view3D);
+    for (const auto& park : shown.parks) {
+        auto vertices = parkTo3DMesh(park, shown.world, meshView3D);
         if (!vertices.empty()) {
-            auto [vao, vbo] = createBuffer(vertices, true);
-            park3DVAOs.push_back(vao);
-            park3DVBOs.push_back(vbo);
-            park3DVertexCounts.push_back(vertices.size() / 5);
+            addMesh(parks3D, vertices);
         }
     }
     
     // Create buffer for fountain (2D points)
-    if (!city.fountain.empty()) {
-        auto vertices = pointsToVertices(city.fountain, screenWidth, screenHeight);
-        auto [vao, vbo] = createBuffer(vertices, false);
-        VAOs.push_back(vao);
-        VBOs.push_back(vbo);
-        vertexCounts.push_back(vertices.size() / 3);
+    if (!shown.fountain.empty()) {
+        addMesh(fountain2D, pointsToVertices(shown.fountain.perimeter(), shown.world));
         
         // Create 3D textured fountain mesh
-        auto vertices3D = fountainTo3DMesh(city.fountain, screenWidth, screenHeight, view3D);
+        auto vertices3D = fountainTo3DMesh(shown.fountain, shown.world, meshView3D);
         if (!vertices3D.empty()) {
-            auto [vao3d, vbo3d] = createBuffer(vertices3D, true);
-            fountain3DVAO = vao3d;
-            fountain3DVBO = vbo3d;
-            fountain3DVertexCount = vertices3D.size() / 5;
+            addMesh(fountain3D, vertices3D);
         }
     }
+}
+
+// Rebuild the 2D road quads
+void CityRenderer::meshRoadLines() {
+    clearGroup(roads2D);
+    for (const auto& road : shown.roads) {
+        addMesh(roads2D, roadToLineMesh(road, shown.world, framebufferWidth, framebufferHeight));
+    }
+}
+
+// Append the buffers of one road
+void CityRenderer::meshRoad(const Road& road) {
+    // 2D line: one quad rather than a point per pixel
+    addMesh(roads2D, roadToLineMesh(road, shown.world, framebufferWidth, framebufferHeight));
     
-    // Create buffers for buildings
-    for (const auto& building : city.buildings) {
-        auto vertices = buildingToVertices(building, screenWidth, screenHeight, view3D);
-        auto [vao, vbo] = createBuffer(vertices, true);
-        VAOs.push_back(vao);
-        VBOs.push_back(vbo);
-        vertexCounts.push_back(vertices.size() / 5);
+    // 3D textured mesh
+    auto vertices = roadTo3DMesh(road, shown.world, meshView3D);
+    if (!vertices.empty()) {
+        addMesh(roads3D, vertices);
+    }
+}
+
+// Replace the 3D road quads with the joined network
+void CityRenderer::joinRoads() {
+    clearGroup(roads3D);
+    auto vertices = roadNetworkTo3DMesh(shown.roads, shown.roadGraph, shown.world, meshView3D);
+    if (!vertices.empty()) {
+        addMesh(roads3D, vertices);
     }
+    
+#ifdef CHECK_ROAD_COVERAGE
+    RoadCoverage coverage = measureRoadCoverage(shown.roads, vertices, shown.world, meshView3D, 2048);
+    std::cout << "Road coverage: " << coverage.holes << " holes, " << coverage.overdrawn
+              << " overdrawn of " << coverage.covered << " samples, " << coverage.zeroArea
+              << " zero-area triangles\n";
+#endif
+}
+
+// Draw a group
+void CityRenderer::drawGroup(const MeshGroup& group, GLenum mode) {
+    if (group.counts.empty()) return;
+    
+    glBindVertexArray(group.VAO);
+    glMultiDrawArrays(mode, group.firsts.data(), group.counts.data(), static_cast<GLsizei>(group.counts.size()));
 }
 
 // Render roads
-void CityRenderer::renderRoads(const CityData& city, bool view3D, ShaderManager& shaderManager,
-                                GLuint roadTexture, size_t roadCount) {
+void CityRenderer::renderRoads(bool view3D, ShaderManager& shaderManager, GLuint roadTexture) {
     if (view3D) {
         // In 3D mode: Draw textured road meshes
         shaderManager.setIs2D(false);
         shaderManager.setUseTexture(true);
         glBindTexture(GL_TEXTURE_2D, roadTexture);
         
-        for (size_t i = 0; i < road3DVAOs.size(); i++) {
-            glBindVertexArray(road3DVAOs[i]);
-            glDrawArrays(GL_TRIANGLES, 0, road3DVertexCounts[i]);
-        }
+        drawGroup(roads3D, GL_TRIANGLES);
         
         shaderManager.setUseTexture(false);
     } else {
-        // In 2D mode: Draw roads as points
+        // In 2D mode: Draw roads as flat lines meshed 2 pixels wide
         shaderManager.setIs2D(true);
         shaderManager.setColor(1.0f, 0.8f, 0.2f);
-        glPointSize(2.0f);
         
-        for (size_t i = 0; i < roadCount && i < VAOs.size(); i++) {
-            glBindVertexArray(VAOs[i]);
-            glDrawArrays(GL_POINTS, 0, vertexCounts[i]);
-        }
+        drawGroup(roads2D, GL_TRIANGLES);
     }
 }
 
 // Render parks
-void CityRenderer::renderParks(const CityData& city, bool view3D, ShaderManager& shaderManager,
-                                GLuint grassTexture, size_t roadCount, size_t parkCount) {
+void CityRenderer::renderParks(bool view3D, ShaderManager& shaderManager, GLuint grassTexture) {
     if (view3D) {
         // In 3D mode: Draw textured grass-filled park meshes
         shaderManager.setIs2D(false);
@@ -212,10 +462,7 @@ void CityRenderer::renderParks(const CityData& city, bool view3D, ShaderManager&
             shaderManager.setColor(0.2f, 0.8f, 0.3f);
         }
         
-        for (size_t i = 0; i < park3DVAOs.size(); i++) {
-            glBindVertexArray(park3DVAOs[i]);
-            glDrawArrays(GL_TRIANGLES, 0, park3DVertexCounts[i]);
-        }
+        drawGroup(parks3D, GL_TRIANGLES);
         
         shaderManager.setUseTexture(false);
     } else {
@@ -223,23 +470,18 @@ void CityRenderer::renderParks(const CityData& city, bool view3D, ShaderManager&
         shaderManager.setIs2D(true);
         shaderManager.setColor(0.2f, 0.8f, 0.3f);
         
-        size_t fountainOffset = roadCount + parkCount;
-        for (size_t i = roadCount; i < fountainOffset && i < VAOs.size(); i++) {
-            glBindVertexArray(VAOs[i]);
-            glDrawArrays(GL_POINTS, 0, vertexCounts[i]);
-        }
+        drawGroup(parks2D, GL_POINTS);
     }
 }
 
 // Render fountain
-void CityRenderer::renderFountain(const CityData& city, bool view3D, ShaderManager& shaderManager,
-                                   GLuint fountainTexture, size_t fountainOffset, size_t fountainCount) {
+void CityRenderer::renderFountain(bool view3D, ShaderManager& shaderManager, GLuint fountainTexture) {
     if (view3D) {
         // In 3D mode: Draw textured fountain mesh
         shaderManager.setIs2D(false);
         shaderManager.setUseTexture(true);
         
-        if (fountain3DVertexCount > 0) {
+        if (!fountain3D.counts.empty()) {
             if (fountainTexture != 0) {
                 glBindTexture(GL_TEXTURE_2D, fountainTexture);
             } else {
@@ -248,151 +490,131 @@ void CityRenderer::renderFountain(const CityData& city, bool view3D, ShaderManag
                 shaderManager.setColor(0.3f, 0.7f, 1.0f);
             }
             
-            glBindVertexArray(fountain3DVAO);
-            glDrawArrays(GL_TRIANGLES, 0, fountain3DVertexCount);
+            drawGroup(fountain3D, GL_TRIANGLES);
         }
         
         shaderManager.setUseTexture(false);
     } else {
         // In 2D mode: Draw fountain as cyan points
         shaderManager.setIs2D(true);
-        if (fountainCount > 0 && fountainOffset < VAOs.size()) {
-            shaderManager.setColor(0.3f, 0.7f, 1.0f);
-            glBindVertexArray(VAOs[fountainOffset]);
-            glDrawArrays(GL_POINTS, 0, vertexCounts[fountainOffset]);
-        }
+        shaderManager.setColor(0.3f, 0.7f, 1.0f);
+        drawGroup(fountain2D, GL_POINTS);
     }
 }
 
 // Render buildings
-void CityRenderer::renderBuildings(const CityData& city, const CityConfig& config, bool view3D, ShaderManager& shaderManager,
-                                    GLuint brickTexture, GLuint concreteTexture, GLuint glassTexture,
-                                    size_t buildingStart) {
+void CityRenderer::renderBuildings(const CityConfig& config, bool view3D, ShaderManager& shaderManager,
+                                    GLuint brickTexture, GLuint concreteTexture, GLuint glassTexture) {
     shaderManager.setIs2D(false);
+    if (instanceCount == 0) return;
     
+    // Every building is drawn in one call; the shader picks the texture
+    // (3D) or colour (2D) of each instance by its material, the building type
     if (view3D) {
         // Use textures in 3D mode based on texture theme
         shaderManager.setUseTexture(true);
         
-        for (size_t i = buildingStart; i < VAOs.size(); i++) {
-            size_t buildingIndex = i - buildingStart;
-            if (buildingIndex < city.buildings.size()) {
-                const Building& building = city.buildings[buildingIndex];
-                
-                // Select texture based on BOTH building type AND texture theme
-                GLuint selectedTexture;
-                
-                switch (config.textureTheme) {
-                    case TextureTheme::MODERN:
-                        // Modern: Glass dominant, some concrete
-                        switch (building.type) {
-                            case BuildingType::LOW_RISE:
-                                selectedTexture = brickTexture;
-                                break;
-                            case BuildingType::MID_RISE:
-                                selectedTexture = concreteTexture;
-                                break;
-                            case BuildingType::HIGH_RISE:
-                                selectedTexture = glassTexture;
-                                break;
-                        }
-                        break;
-                        
-                    case TextureTheme::CLASSIC:
-                        // Classic: Brick dominant, traditional materials
-                        switch (building.type) {
-                            case BuildingType::LOW_RISE:
-                                selectedTexture = brickTexture;
-                                break;
-                            case BuildingType::MID_RISE:
-                                selectedTexture = brickTexture;  // More brick!
-                                break;
-                            case BuildingType::HIGH_RISE:
-                                selectedTexture = concreteTexture;  // Less glass
-                                break;
-                        }
-                        break;
-                        
-                    case TextureTheme::INDUSTRIAL:
-                        // Industrial: Concrete/metal dominant
-                        switch (building.type) {
-                            case BuildingType::LOW_RISE:
-                                selectedTexture = concreteTexture;  // Industrial materials
-                                break;
-                            case BuildingType::MID_RISE:
-                                selectedTexture = concreteTexture;
-                                break;
-                            case BuildingType::HIGH_RISE:
-                                selectedTexture = concreteTexture;  // Minimal glass
-                                break;
-                        }
-                        break;
-                        
-                    case TextureTheme::FUTURISTIC:
-                        // Futuristic: Glass everywhere
-                        switch (building.type) {
-                            case BuildingType::LOW_RISE:
-                                selectedTexture = glassTexture;  // Even low buildings are glass
-                                break;
-                            case BuildingType::MID_RISE:
-                                selectedTexture = glassTexture;
-                                break;
-                            case BuildingType::HIGH_RISE:
-                                selectedTexture = glassTexture;
-                                break;
-                        }
-                        break;
-                }
-                
-                glBindTexture(GL_TEXTURE_2D, selectedTexture);
-                glBindVertexArray(VAOs[i]);
-                glDrawArrays(GL_TRIANGLES, 0, vertexCounts[i]);
+        for (int t = 0; t < BUILDING_TYPE_COUNT; t++) {
+            BuildingType type = static_cast<BuildingType>(t);
+            
+            // Select texture based on BOTH building type AND texture theme
+            GLuint selectedTexture;
+            
+            switch (config.textureTheme) {
+                case TextureTheme::MODERN:
+                    // Modern: Glass dominant, some concrete
+                    switch (type) {
+                        case BuildingType::LOW_RISE:
+                            selectedTexture = brickTexture;
+                            break;
+                        case BuildingType::MID_RISE:
+                            selectedTexture = concreteTexture;
+                            break;
+                        case BuildingType::HIGH_RISE:
+                            selectedTexture = glassTexture;
+                            break;
+                    }
+                    break;
+                    
+                case TextureTheme::CLASSIC:
+                    // Classic: Brick dominant, traditional materials
+                    switch (type) {
+                        case BuildingType::LOW_RISE:
+                            selectedTexture = brickTexture;
+                            break;
+                        case BuildingType::MID_RISE:
+                            selectedTexture = brickTexture;  // More brick!
+                            break;
+                        case BuildingType::HIGH_RISE:
+                            selectedTexture = concreteTexture;  // Less glass
+                            break;
+                    }
+                    break;
+                    
+                case TextureTheme::INDUSTRIAL:
+                    // Industrial: Concrete/metal dominant
+                    switch (type) {
+                        case BuildingType::LOW_RISE:
+                            selectedTexture = concreteTexture;  // Industrial materials
+                            break;
+                        case BuildingType::MID_RISE:
+                            selectedTexture = concreteTexture;
+                            break;
+                        case BuildingType::HIGH_RISE:
+                            selectedTexture = concreteTexture;  // Minimal glass
+                            break;
+                    }
+                    break;
+                    
+                case TextureTheme::FUTURISTIC:
+                    // Futuristic: Glass everywhere
+                    switch (type) {
+                        case BuildingType::LOW_RISE:
+                            selectedTexture = glassTexture;  // Even low buildings are glass
+                            break;
+                        case BuildingType::MID_RISE:
+                            selectedTexture = glassTexture;
+                            break;
+                        case BuildingType::HIGH_RISE:
+                            selectedTexture = glassTexture;
+                            break;
+                    }
+                    break;
             }
+            
+            // Material t samples texture unit t
+            glActiveTexture(GL_TEXTURE0 + t);
+            glBindTexture(GL_TEXTURE_2D, selectedTexture);
         }
+        glActiveTexture(GL_TEXTURE0);
     } else {
         // Use colors in 2D mode
         shaderManager.setUseTexture(false);
         
-        for (size_t i = buildingStart; i < VAOs.size(); i++) {
-            size_t buildingIndex = i - buildingStart;
-            if (buildingIndex < city.buildings.size()) {
-                const Building& building = city.buildings[buildingIndex];
-                
-                // Set color based on building type
-                switch (building.type) {
-                    case BuildingType::LOW_RISE:
-                        shaderManager.setColor(0.7f, 0.4f, 0.3f);  // Brick red
-                        break;
-                    case BuildingType::MID_RISE:
-                        shaderManager.setColor(0.5f, 0.5f, 0.5f);  // Gray
-                        break;
-                    case BuildingType::HIGH_RISE:
-                        shaderManager.setColor(0.6f, 0.7f, 0.8f);  // Glass blue
-                        break;
-                }
-                
-                glBindVertexArray(VAOs[i]);
-                glDrawArrays(GL_TRIANGLES, 0, vertexCounts[i]);
-            }
-        }
+        // Set color based on building type
+        const float colors[BUILDING_TYPE_COUNT * 3] = {
+            0.7f, 0.4f, 0.3f,   // LOW_RISE: Brick red
+            0.5f, 0.5f, 0.5f,   // MID_RISE: Gray
+            0.6f, 0.7f, 0.8f    // HIGH_RISE: Glass blue
+        };
+        shaderManager.setMaterialColors(colors);
     }
+    
+    shaderManager.setInstanced(true);
+    glBindVertexArray(buildingVAO);
+    glDrawElementsInstanced(GL_TRIANGLES, BUILDING_INDEX_COUNT, GL_UNSIGNED_SHORT, (void*)0, instanceCount);
+    shaderManager.setInstanced(false);
 }
 
 // Main render function
-void CityRenderer::render(const CityData& city, const CityConfig& config, bool view3D, ShaderManager& shaderManager,
+void CityRenderer::render(const CityConfig& config, bool view3D, ShaderManager& shaderManager,
                           GLuint brickTexture, GLuint concreteTexture, GLuint glassTexture,
                           GLuint roadTexture, GLuint grassTexture, GLuint fountainTexture) {
     if (!isReady()) return;
     
-    size_t roadCount = city.roads.size();
-    size_t parkCount = city.parks.size();
-    size_t fountainOffset = roadCount + parkCount;
-    size_t fountainCount = city.fountain.empty() ? 0 : 1;
-    size_t buildingStart = fountainOffset + fountainCount;
-    
     // Render each city element
-    renderRoads(city, view3D, shaderManager, roadTexture, roadCount);
-    renderParks(city, view3D, shaderManager, grassTexture, roadCount, parkCount);
-    renderFountain(city, view3D, shaderManager, fountainTexture, fountainOffset, fountainCount);
-    renderBuildings(city, config, view3D, shaderManager, brickTexture, concreteTexture, glassTexture, buildingStart);
+    renderRoads(view3D, shaderManager, roadTexture);
+    renderParks(view3D, shaderManager, grassTexture);
+    renderFountain(view3D, shaderManager, fountainTexture);
+    renderBuildings(config, view3D, shaderManager, brickTexture, concreteTexture, glassTexture);
 }
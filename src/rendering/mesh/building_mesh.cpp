@@ -9,158 +9,65 @@
 #include "rendering/mesh/building_mesh.h"
 #include <vector>
 
-std::vector<float> buildingToVertices(const Building& building, int screenWidth, int screenHeight, bool is3D) {
+const uint16_t BUILDING_INDICES[BUILDING_INDEX_COUNT] = {
+    0, 2, 3,    0, 3, 1,    // Front wall
+    2, 4, 5,    2, 5, 3,    // Right wall
+    4, 6, 7,    4, 7, 5,    // Back wall
+    6, 8, 9,    6, 9, 7,    // Left wall
+    10, 11, 12, 10, 12, 13  // Roof
+};
+
+std::vector<float> unitBuildingVertices(bool is3D) {
     std::vector<float> vertices;
+    vertices.reserve(BUILDING_VERTEX_COUNT * 5);
     
-    // Convert pixel coordinates to world coordinates
-    float centerX = (building.x / (screenWidth / 2.0f)) - 1.0f;
-    float centerY = 1.0f - (building.y / (screenHeight / 2.0f));
-    float halfWidth = building.width / (screenWidth / 2.0f);
-    float halfDepth = building.depth / (screenHeight / 2.0f);
-    float heightNorm = building.height / 300.0f;  // Normalize height for viewing
+    // 3D MODE: X=left/right, Y=up/down HEIGHT!, Z=depth
+    // 2D MODE: Keep original coordinate system (Y for depth, Z for height)
+    auto addVertex = [&](float x, float depth, float height, float u, float v) {
+        if (is3D) {
+            vertices.insert(vertices.end(), { x, height, depth, u, v });
+        } else {
+            vertices.insert(vertices.end(), { x, depth, height, u, v });
+        }
+    };
     
-    if (!is3D) {
-        // 2D MODE: Keep original coordinate system (Y for depth, Z for height)
-        float x0 = centerX - halfWidth;
-        float x1 = centerX + halfWidth;
-        float y0 = centerY - halfDepth;
-        float y1 = centerY + halfDepth;
-        float z0 = 0.0f;
-        float z1 = heightNorm;
-        
-        // Front face
-        vertices.insert(vertices.end(), {
-            x0, y0, z0,  0.0f, 0.0f,
-            x1, y0, z0,  1.0f, 0.0f,
-            x1, y0, z1,  1.0f, 1.0f,
-            x0, y0, z0,  0.0f, 0.0f,
-            x1, y0, z1,  1.0f, 1.0f,
-            x0, y0, z1,  0.0f, 1.0f
-        });
-        
-        // Back face
-        vertices.insert(vertices.end(), {
-            x1, y1, z0,  0.0f, 0.0f,
-            x0, y1, z0,  1.0f, 0.0f,
-            x0, y1, z1,  1.0f, 1.0f,
-            x1, y1, z0,  0.0f, 0.0f,
-            x0, y1, z1,  1.0f, 1.0f,
-            x1, y1, z1,  0.0f, 1.0f
-        });
-        
-        // Left face
-        vertices.insert(vertices.end(), {
-            x0, y1, z0,  0.0f, 0.0f,
-            x0, y0, z0,  1.0f, 0.0f,
-            x0, y0, z1,  1.0f, 1.0f,
-            x0, y1, z0,  0.0f, 0.0f,
-            x0, y0, z1,  1.0f, 1.0f,
-            x0, y1, z1,  0.0f, 1.0f
-        });
-        
-        // Right face
-        vertices.insert(vertices.end(), {
-            x1, y0, z0,  0.0f, 0.0f,
-            x1, y1, z0,  1.0f, 0.0f,
-            x1, y1, z1,  1.0f, 1.0f,
-            x1, y0, z0,  0.0f, 0.0f,
-            x1, y1, z1,  1.0f, 1.0f,
-            x1, y0, z1,  0.0f, 1.0f
-        });
-        
-        // Bottom face
-        vertices.insert(vertices.end(), {
-            x0, y0, z0,  0.0f, 0.0f,
-            x0, y1, z0,  0.0f, 1.0f,
-            x1, y1, z0,  1.0f, 1.0f,
-            x0, y0, z0,  0.0f, 0.0f,
-            x1, y1, z0,  1.0f, 1.0f,
-            x1, y0, z0,  1.0f, 0.0f
-        });
-        
-        // Top face
-        vertices.insert(vertices.end(), {
-            x0, y0, z1,  0.0f, 0.0f,
-            x1, y0, z1,  1.0f, 0.0f,
-            x1, y1, z1,  1.0f, 1.0f,
-            x0, y0, z1,  0.0f, 0.0f,
-            x1, y1, z1,  1.0f, 1.0f,
-            x0, y1, z1,  0.0f, 1.0f
-        });
-        
-        return vertices;
+    // Walls: front (-depth), right (+X), back (+depth), left (-X), each
+    // running from bottom-left to bottom-right as seen from outside
+    const float ringX[] = { -1.0f, 1.0f, 1.0f, -1.0f, -1.0f };
+    const float ringDepth[] = { -1.0f, -1.0f, 1.0f, 1.0f, -1.0f };
+    for (int i = 0; i < 5; i++) {
+        addVertex(ringX[i], ringDepth[i], 0.0f, static_cast<float>(i), 0.0f);
+        addVertex(ringX[i], ringDepth[i], 1.0f, static_cast<float>(i), 1.0f);
     }
     
-    // 3D MODE: Use proper coordinate system (X=left/right, Y=up/down HEIGHT!, Z=depth)
-    float centerZ = 1.0f - (building.y / (screenHeight / 2.0f));
-    
-    // Calculate the 8 corners of the cube
-    float x0 = centerX - halfWidth;
-    float x1 = centerX + halfWidth;
-    float y0 = 0.0f;           // Ground level
-    float y1 = heightNorm;     // Top of building (HEIGHT goes UP!)
-    float z0 = centerZ - halfDepth;
-    float z1 = centerZ + halfDepth;
-    
-    // Front face (facing -Z direction) - with UV coordinates
-    vertices.insert(vertices.end(), {
-        x0, y0, z0,  0.0f, 0.0f,
-        x1, y0, z0,  1.0f, 0.0f,
-        x1, y1, z0,  1.0f, 1.0f,
-        x0, y0, z0,  0.0f, 0.0f,
-        x1, y1, z0,  1.0f, 1.0f,
-        x0, y1, z0,  0.0f, 1.0f
-    });
-    
-    // Back face (facing +Z direction)
-    vertices.insert(vertices.end(), {
-        x1, y0, z1,  0.0f, 0.0f,
-        x0, y0, z1,  1.0f, 0.0f,
-        x0, y1, z1,  1.0f, 1.0f,
-        x1, y0, z1,  0.0f, 0.0f,
-        x0, y1, z1,  1.0f, 1.0f,
-        x1, y1, z1,  0.0f, 1.0f
-    });
-    
-    // Left face (facing -X direction)
-    vertices.insert(vertices.end(), {
-        x0, y0, z1,  0.0f, 0.0f,
-        x0, y0, z0,  1.0f, 0.0f,
-        x0, y1, z0,  1.0f, 1.0f,
-        x0, y0, z1,  0.0f, 0.0f,
-        x0, y1, z0,  1.0f, 1.0f,
-        x0, y1, z1,  0.0f, 1.0f
-    });
-    
-    // Right face (facing +X direction)
-    vertices.insert(vertices.end(), {
-        x1, y0, z0,  0.0f, 0.0f,
-        x1, y0, z1,  1.0f, 0.0f,
-        x1, y1, z1,  1.0f, 1.0f,
-        x1, y0, z0,  0.0f, 0.0f,
-        x1, y1, z1,  1.0f, 1.0f,
-        x1, y0, z1,  0.0f, 1.0f
-    });
-    
-    // Bottom face (ground, facing -Y direction)
-    vertices.insert(vertices.end(), {
-        x0, y0, z0,  0.0f, 0.0f,
-        x0, y0, z1,  0.0f, 1.0f,
-        x1, y0, z1,  1.0f, 1.0f,
-        x0, y0, z0,  0.0f, 0.0f,
-        x1, y0, z1,  1.0f, 1.0f,
-        x1, y0, z0,  1.0f, 0.0f
-    });
-    
-    // Top face (roof, facing +Y direction)
-    vertices.insert(vertices.end(), {
-        x0, y1, z0,  0.0f, 0.0f,
-        x1, y1, z0,  1.0f, 0.0f,
-        x1, y1, z1,  1.0f, 1.0f,
-        x0, y1, z0,  0.0f, 0.0f,
-        x1, y1, z1,  1.0f, 1.0f,
-        x0, y1, z1,  0.0f, 1.0f
-    });
+    // Roof
+    addVertex(-1.0f, -1.0f, 1.0f, 0.0f, 0.0f);
+    addVertex(1.0f, -1.0f, 1.0f, 1.0f, 0.0f);
+    addVertex(1.0f, 1.0f, 1.0f, 1.0f, 1.0f);
+    addVertex(-1.0f, 1.0f, 1.0f, 0.0f, 1.0f);
     
     return vertices;
 }
+
+BuildingInstance buildingToInstance(const Building& building, const WorldExtent& world, bool is3D) {
+    // Convert world coordinates to view coordinates
+    float centerX = world.toViewX(building.x);
+    float centerY = world.toViewY(building.y);
+    float halfWidth = world.toViewSizeX(building.width);
+    float halfDepth = world.toViewSizeY(building.depth);
+    // Heights shrink with the world like footprints do (height / 300 at the default size)
+    float heightNorm = world.toViewSizeY(building.height);
+    
+    BuildingInstance instance;
+    if (is3D) {
+        instance.offset[0] = centerX;   instance.scale[0] = halfWidth;
+        instance.offset[1] = 0.0f;      instance.scale[1] = heightNorm;
+        instance.offset[2] = centerY;   instance.scale[2] = halfDepth;
+    } else {
+        instance.offset[0] = centerX;   instance.scale[0] = halfWidth;
+        instance.offset[1] = centerY;   instance.scale[1] = halfDepth;
+        instance.offset[2] = 0.0f;      instance.scale[2] = heightNorm;
+    }
+    instance.material = static_cast<int32_t>(building.type);
+    return instance;
+}
@@ -13,27 +13,19 @@
 #define M_PI 3.14159265358979323846
 #endif
 
-std::vector<float> parkTo3DMesh(const std::vector<Point>& parkPoints, 
-                                 int screenWidth, int screenHeight, bool is3D) {
+std::vector<float> parkTo3DMesh(const Circle& park, 
+                                 const WorldExtent& world, bool is3D) {
     std::vector<float> vertices;
     
-    if (parkPoints.size() < 3) return vertices;
+    if (park.empty()) return vertices;
     
-    // Find center and radius from the circle points
-    float centerX = 0.0f, centerZ = 0.0f;
-    for (const auto& pt : parkPoints) {
-        float x = (pt.x / (screenWidth / 2.0f)) - 1.0f;
-        float z = 1.0f - (pt.y / (screenHeight / 2.0f));
-        centerX += x;
-        centerZ += z;
-    }
-    centerX /= parkPoints.size();
-    centerZ /= parkPoints.size();
-    
-    // Calculate radius from first point
-    float x0 = (parkPoints[0].x / (screenWidth / 2.0f)) - 1.0f;
-    float z0 = 1.0f - (parkPoints[0].y / (screenHeight / 2.0f));
-    float radius = std::sqrt((x0 - centerX) * (x0 - centerX) + (z0 - centerZ) * (z0 - centerZ));
+    // Convert the circle center to normalized coordinates. The radius is
+    // scaled per axis so the mesh matches the world-space circle that
+    // roads and buildings were placed around.
+    float centerX = world.toViewX(park.centerX);
+    float centerZ = world.toViewY(park.centerY);
+    float radiusX = world.toViewSizeX(park.radius);
+    float radiusZ = world.toViewSizeY(park.radius);
     
     float parkHeight = 0.006f;  // Above roads (roads at 0.005f) to prevent overlap
     int segments = 32;  // Number of triangles to form circle
@@ -43,10 +35,10 @@ std::vector<float> parkTo3DMesh(const std::vector<Point>& parkPoints,
         float angle1 = (i * 2.0f * M_PI) / segments;
         float angle2 = ((i + 1) * 2.0f * M_PI) / segments;
         
-        float x1 = centerX + radius * std::cos(angle1);
-        float z1 = centerZ + radius * std::sin(angle1);
-        float x2 = centerX + radius * std::cos(angle2);
-        float z2 = centerZ + radius * std::sin(angle2);
+        float x1 = centerX + radiusX * std::cos(angle1);
+        float z1 = centerZ + radiusZ * std::sin(angle1);
+        float x2 = centerX + radiusX * std::cos(angle2);
+        float z2 = centerZ + radiusZ * std::sin(angle2);
         
         // UV coordinates for texture mapping
         float u_center = 0.5f;
@@ -76,27 +68,19 @@ std::vector<float> parkTo3DMesh(const std::vector<Point>& parkPoints,
     return vertices;
 }
 
-std::vector<float> fountainTo3DMesh(const std::vector<Point>& fountainPoints, 
-                                     int screenWidth, int screenHeight, bool is3D) {
+std::vector<float> fountainTo3DMesh(const Circle& fountain, 
+                                     const WorldExtent& world, bool is3D) {
     std::vector<float> vertices;
     
-    if (fountainPoints.size() < 3) return vertices;
-    
-    // Find center and radius from the circle points
-    float centerX = 0.0f, centerZ = 0.0f;
-    for (const auto& pt : fountainPoints) {
-        float x = (pt.x / (screenWidth / 2.0f)) - 1.0f;
-        float z = 1.0f - (pt.y / (screenHeight / 2.0f));
-        centerX += x;
-        centerZ += z;
-    }
-    centerX /= fountainPoints.size();
-    centerZ /= fountainPoints.size();
+    if (fountain.empty()) return vertices;
     
-    // Calculate radius from first point
-    float x0 = (fountainPoints[0].x / (screenWidth / 2.0f)) - 1.0f;
-    float z0 = 1.0f - (fountainPoints[0].y / (screenHeight / 2.0f));
-    float radius = std::sqrt((x0 - centerX) * (x0 - centerX) + (z0 - centerZ) * (z0 - centerZ));
+    // Convert the circle center to normalized coordinates. The radius is
+    // scaled per axis so the mesh matches the world-space circle that
+    // roads and buildings were placed around.
+    float centerX = world.toViewX(fountain.centerX);
+    float centerZ = world.toViewY(fountain.centerY);
+    float radiusX = world.toViewSizeX(fountain.radius);
+    float radiusZ = world.toViewSizeY(fountain.radius);
     
     float fountainHeight = 0.008f;  // Above parks (parks at 0.006f) to make it stand out
     int segments = 32;  // Number of triangles to form circle
@@ -106,10 +90,10 @@ std::vector<float> fountainTo3DMesh(const std::vector<Point>& fountainPoints,
         float angle1 = (i * 2.0f * M_PI) / segments;
         float angle2 = ((i + 1) * 2.0f * M_PI) / segments;
         
-        float x1 = centerX + radius * std::cos(angle1);
-        float z1 = centerZ + radius * std::sin(angle1);
-        float x2 = centerX + radius * std::cos(angle2);
-        float z2 = centerZ + radius * std::sin(angle2);
+        float x1 = centerX + radiusX * std::cos(angle1);
+        float z1 = centerZ + radiusZ * std::sin(angle1);
+        float x2 = centerX + radiusX * std::cos(angle2);
+        float z2 = centerZ + radiusZ * std::sin(angle2);
         
         // UV coordinates for texture mapping
         float u_center = 0.5f;
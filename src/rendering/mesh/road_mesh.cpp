@@ -7,82 +7,790 @@
  */
 
 #include "rendering/mesh/road_mesh.h"
+#include "generation/spatial_grid.h"
+#include "utils/geometry.h"
 #include <glm/glm.hpp>
+#include <algorithm>
 #include <cmath>
+#include <iostream>
+#include <map>
+#include <utility>
 
-std::vector<float> roadTo3DMesh(const Road& road, int screenWidth, int screenHeight, bool is3D) {
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static const float ROAD_HEIGHT = 0.005f;        // Slightly above ground
+static const float TEXTURE_REPEAT = 5.0f;       // Texture repeats along a road per view unit
+static const float PARALLEL_EPSILON = 1e-4f;    // Sine of the angle below which arms count as parallel
+static const float OVERLAP_EPSILON = 1e-4f;     // Depth in view units below which surfaces only touch
+static const float POINT_EPSILON = 1e-6f;       // Distance in view units below which corners coincide
+
+// 2D roads are drawn 2 pixels wide, like the 2px points they were once drawn with
+static const float LINE_WIDTH_PIXELS = 2.0f;
+
+// Clip a road's centre line to the world margins and convert its ends to
+// view coordinates. Returns false if nothing of the road is left.
+static bool clipRoadToView(const Road& road, const WorldExtent& world,
+                           float& x1, float& z1, float& x2, float& z2) {
+    float px0 = road.x0(), py0 = road.y0();
+    float px1 = road.x1(), py1 = road.y1();
+    float tMin = 0.0f, tMax = 1.0f;
+    if (!clipSegmentToBox(px0, py0, px1, py1,
+                          world.margin, world.margin, world.width - world.margin, world.height - world.margin,
+                          tMin, tMax)) {
+        return false;  // Road lies entirely outside bounds
+    }
+    
+    // Convert world coordinates to normalized device coordinates
+    x1 = world.toViewX(px0 + (px1 - px0) * tMin);
+    z1 = world.toViewY(py0 + (py1 - py0) * tMin);
+    x2 = world.toViewX(px0 + (px1 - px0) * tMax);
+    z2 = world.toViewY(py0 + (py1 - py0) * tMax);
+    
+    return !(x1 == x2 && z1 == z2);  // Degenerate segment
+}
+
+// Append one vertex on the road surface
+static void addRoadVertex(std::vector<float>& vertices, const glm::vec2& p, float u, float v, bool is3D) {
+    if (is3D) {
+        // 3D MODE: Y is UP
+        vertices.insert(vertices.end(), { p.x, ROAD_HEIGHT, p.y, u, v });
+    } else {
+        // 2D MODE: Z is depth (for orthographic view)
+        vertices.insert(vertices.end(), { p.x, p.y, ROAD_HEIGHT, u, v });
+    }
+}
+
+// Append the quad (2 triangles) of a road strip from a to b. The texture
+// runs across the width in U and along the road in V, from vA to vB.
+static void addRoadQuad(std::vector<float>& vertices, const glm::vec2& a, const glm::vec2& b,
+                        float halfWidth, float vA, float vB, bool is3D) {
+    // Calculate direction and perpendicular
+    glm::vec2 dir = glm::normalize(b - a);
+    glm::vec2 perp(-dir.y, dir.x);  // Perpendicular for width
+    
+    // Four corners of the road quad
+    glm::vec2 v1 = a + perp * halfWidth;
+    glm::vec2 v2 = a - perp * halfWidth;
+    glm::vec2 v3 = b + perp * halfWidth;
+    glm::vec2 v4 = b - perp * halfWidth;
+    
+    // First triangle
+    addRoadVertex(vertices, v1, 0.0f, vA, is3D);
+    addRoadVertex(vertices, v2, 1.0f, vA, is3D);
+    addRoadVertex(vertices, v3, 0.0f, vB, is3D);
+    
+    // Second triangle
+    addRoadVertex(vertices, v2, 1.0f, vA, is3D);
+    addRoadVertex(vertices, v4, 1.0f, vB, is3D);
+    addRoadVertex(vertices, v3, 0.0f, vB, is3D);
+}
+
+std::vector<float> roadToLineMesh(const Road& road, const WorldExtent& world,
+                                  int framebufferWidth, int framebufferHeight) {
     std::vector<float> vertices;
     
-    if (road.points.size() < 2) return vertices;
-    
-    // Convert road width from pixels to normalized coordinates
-    // screenWidth pixels maps to 2.0 in normalized coords (-1.0 to 1.0)
-    float roadWidth = (road.width / (float)screenWidth) * 2.0f;
-    int margin = 50;  // Boundary margin in pixels
-    
-    // Process each segment of the road
-    for (size_t i = 0; i < road.points.size() - 1; i++) {
-        // Skip points outside screen boundaries
-        if (road.points[i].x < margin || road.points[i].x > screenWidth - margin ||
-            road.points[i].y < margin || road.points[i].y > screenHeight - margin ||
-            road.points[i + 1].x < margin || road.points[i + 1].x > screenWidth - margin ||
-            road.points[i + 1].y < margin || road.points[i + 1].y > screenHeight - margin) {
-            continue;  // Skip this segment if either endpoint is outside bounds
-        }
-        
-        // Convert pixel coordinates to normalized device coordinates
-        float x1 = (road.points[i].x / (screenWidth / 2.0f)) - 1.0f;
-        float z1 = 1.0f - (road.points[i].y / (screenHeight / 2.0f));
-        float x2 = (road.points[i + 1].x / (screenWidth / 2.0f)) - 1.0f;
-        float z2 = 1.0f - (road.points[i + 1].y / (screenHeight / 2.0f));
-        
-        // Calculate direction and perpendicular
-        glm::vec2 dir = glm::normalize(glm::vec2(x2 - x1, z2 - z1));
-        glm::vec2 perp(-dir.y, dir.x);  // Perpendicular for width
-        
-        float halfWidth = roadWidth / 2.0f;
-        
-        // Four corners of road segment
-        glm::vec2 v1(x1 + perp.x * halfWidth, z1 + perp.y * halfWidth);
-        glm::vec2 v2(x1 - perp.x * halfWidth, z1 - perp.y * halfWidth);
-        glm::vec2 v3(x2 + perp.x * halfWidth, z2 + perp.y * halfWidth);
-        glm::vec2 v4(x2 - perp.x * halfWidth, z2 - perp.y * halfWidth);
-        
-        float roadHeight = 0.005f;  // Slightly above ground
-        float texRepeat = glm::length(glm::vec2(x2 - x1, z2 - z1)) * 5.0f;  // Texture repeats along road
-        
-        if (is3D) {
-            // 3D MODE: Y is UP
-            // First triangle
-            vertices.insert(vertices.end(), {
-                v1.x, roadHeight, v1.y,  0.0f, 0.0f,
-                v2.x, roadHeight, v2.y,  1.0f, 0.0f,
-                v3.x, roadHeight, v3.y,  0.0f, texRepeat
-            });
+    float x1, y1, x2, y2;
+    if (!clipRoadToView(road, world, x1, y1, x2, y2)) {
+        return vertices;
+    }
+    
+    // Offset the ends in pixels, where the width is the same in every
+    // direction, then go back to view units. The quad reaches half the width
+    // past each end, so lines have square caps like the points did.
+    glm::vec2 pixel(2.0f / framebufferWidth, 2.0f / framebufferHeight);
+    glm::vec2 a(x1, y1);
+    glm::vec2 b(x2, y2);
+    glm::vec2 dir = glm::normalize((b - a) / pixel) * (LINE_WIDTH_PIXELS / 2.0f);
+    glm::vec2 along = dir * pixel;
+    glm::vec2 across = glm::vec2(-dir.y, dir.x) * pixel;
+    
+    glm::vec2 v1 = a - along + across;
+    glm::vec2 v2 = a - along - across;
+    glm::vec2 v3 = b + along + across;
+    glm::vec2 v4 = b + along - across;
+    vertices.insert(vertices.end(), {
+        v1.x, v1.y, 0.0f,
+        v2.x, v2.y, 0.0f,
+        v3.x, v3.y, 0.0f,
+        v2.x, v2.y, 0.0f,
+        v4.x, v4.y, 0.0f,
+        v3.x, v3.y, 0.0f
+    });
+    return vertices;
+}
+
+std::vector<float> roadTo3DMesh(const Road& road, const WorldExtent& world, bool is3D) {
+    std::vector<float> vertices;
+    
+    // Convert road width from world units to normalized coordinates
+    float roadWidth = world.toViewSizeX(road.width);
+    
+    // Clip the road's centre line to the world boundaries
+    float x1, z1, x2, z2;
+    if (!clipRoadToView(road, world, x1, z1, x2, z2)) {
+        return vertices;
+    }
+    
+    glm::vec2 a(x1, z1);
+    glm::vec2 b(x2, z2);
+    addRoadQuad(vertices, a, b, roadWidth / 2.0f, 0.0f, glm::length(b - a) * TEXTURE_REPEAT, is3D);
+    
+    return vertices;
+}
+
+namespace {
+
+// How the strips of two neighbouring arms of a junction meet
+enum class Join {
+    OVERLAP,    // No corner closes the join; both strips run on to the junction point
+    MITER,      // The facing edges meet in one corner
+    BEVEL       // Outside of a bend; the patch closes straight across
+};
+
+// A road edge leaving a junction, in view space
+struct JunctionArm {
+    int edge;
+    bool atStart;       // Whether the junction is at the edge's tStart end
+    glm::vec2 dir;      // Unit direction away from the junction
+    float halfWidth;
+    float angle;        // Of dir, for ordering arms counter-clockwise
+    float maxTrim;      // Half the edge length; the other end may need the rest
+    float trim;         // Distance from the junction where the strip starts
+};
+
+float cross(const glm::vec2& a, const glm::vec2& b) {
+    return a.x * b.y - a.y * b.x;
+}
+
+// A convex piece of the road surface in view space, a junction patch or a
+// strip, with the affine texture mapping of the polygon it came from
+struct Surface {
+    size_t first;               // Offset of the corners in SurfaceList
+    size_t count;
+    glm::vec2 low, high;        // Bounding box
+    glm::vec2 origin;           // Point with texture coordinates uv
+    glm::vec2 uv;
+    glm::vec2 uAxis, vAxis;     // Change of U and V per view unit
+    
+    glm::vec2 uvAt(const glm::vec2& p) const {
+        return uv + glm::vec2(glm::dot(p - origin, uAxis), glm::dot(p - origin, vAxis));
+    }
+};
+
+// Surfaces with their corners and, for the side from each corner to the
+// next, the unit normal pointing into the surface
+struct SurfaceList {
+    std::vector<Surface> surfaces;
+    std::vector<glm::vec2> corners;
+    std::vector<glm::vec2> normals;
+    
+    // Add a convex polygon, textured like 'mapping'. Coinciding corners
+    // are merged; what has no area left is not added.
+    void add(const std::vector<glm::vec2>& polygon, Surface mapping) {
+        mapping.first = corners.size();
+        for (const glm::vec2& p : polygon) {
+            if (corners.size() == mapping.first || glm::length(p - corners.back()) > POINT_EPSILON) {
+                corners.push_back(p);
+            }
+        }
+        while (corners.size() > mapping.first + 1 &&
+               glm::length(corners.back() - corners[mapping.first]) <= POINT_EPSILON) {
+            corners.pop_back();
+        }
+        mapping.count = corners.size() - mapping.first;
+        
+        float area = 0.0f;
+        for (size_t i = 0; i < mapping.count; i++) {
+            area += cross(corners[mapping.first + i], corners[mapping.first + (i + 1) % mapping.count]);
+        }
+        if (mapping.count < 3 || area == 0.0f) {
+            corners.resize(mapping.first);
+            return;
+        }
+        
+        mapping.low = mapping.high = corners[mapping.first];
+        for (size_t i = 0; i < mapping.count; i++) {
+            const glm::vec2& p = corners[mapping.first + i];
+            const glm::vec2& q = corners[mapping.first + (i + 1) % mapping.count];
+            glm::vec2 normal = glm::normalize(glm::vec2(p.y - q.y, q.x - p.x));
+            normals.push_back(area > 0.0f ? normal : -normal);
+            mapping.low = glm::min(mapping.low, p);
+            mapping.high = glm::max(mapping.high, p);
+        }
+        surfaces.push_back(mapping);
+    }
+};
+
+// Convex polygons stored back to back, so that cutting surfaces into
+// pieces allocates nothing once the buffers have grown
+struct PolygonList {
+    std::vector<glm::vec2> points;
+    std::vector<size_t> ends;       // One past the last point of each polygon
+    
+    void clear() {
+        points.clear();
+        ends.clear();
+    }
+    
+    void add(const glm::vec2* polygon, size_t count) {
+        points.insert(points.end(), polygon, polygon + count);
+        ends.push_back(points.size());
+    }
+    
+    size_t size() const { return ends.size(); }
+    size_t first(size_t i) const { return (i == 0) ? 0 : ends[i - 1]; }
+};
+
+// Whether a polygon is convex and counter-clockwise: it only turns left,
+// and its sides point along +X only once, so it winds once. Coinciding
+// corners count as one.
+bool isConvex(const std::vector<glm::vec2>& polygon, std::vector<glm::vec2>& sides) {
+    sides.clear();
+    for (size_t i = 0; i < polygon.size(); i++) {
+        glm::vec2 side = polygon[(i + 1) % polygon.size()] - polygon[i];
+        if (glm::length(side) > POINT_EPSILON) sides.push_back(side);
+    }
+    if (sides.size() < 3) return false;
+    
+    int windings = 0;
+    for (size_t i = 0; i < sides.size(); i++) {
+        const glm::vec2& side = sides[i];
+        const glm::vec2& next = sides[(i + 1) % sides.size()];
+        float turn = cross(side, next);
+        if (turn < 0.0f || (turn == 0.0f && glm::dot(side, next) < 0.0f)) return false;
+        if (side.y < 0.0f && next.y >= 0.0f) windings++;
+    }
+    return windings == 1;
+}
+
+// Whether a polygon is no wider than POINT_EPSILON, like the slivers left
+// where a cut runs along a side the two surfaces share, or a fan triangle
+// over corners on one line
+bool isSliver(const glm::vec2* polygon, size_t count) {
+    float area = 0.0f;
+    float longest = 0.0f;
+    for (size_t i = 0; i < count; i++) {
+        const glm::vec2& p = polygon[i];
+        const glm::vec2& q = polygon[(i + 1) % count];
+        area += cross(p - polygon[0], q - polygon[0]);
+        longest = std::max(longest, glm::length(q - p));
+    }
+    return std::fabs(area) <= POINT_EPSILON * longest;
+}
+
+// Sutherland-Hodgman step: the part of a convex polygon where
+// dot(p - point, normal) >= 0
+void clipToHalfPlane(const glm::vec2* polygon, size_t count, const glm::vec2& point,
+                     const glm::vec2& normal, std::vector<glm::vec2>& out) {
+    out.clear();
+    for (size_t i = 0; i < count; i++) {
+        const glm::vec2& p = polygon[i];
+        const glm::vec2& q = polygon[(i + 1) % count];
+        float dp = glm::dot(p - point, normal);
+        float dq = glm::dot(q - point, normal);
+        if (dp >= 0.0f) out.push_back(p);
+        if ((dp >= 0.0f) != (dq >= 0.0f)) {
+            out.push_back(p + (q - p) * (dp / (dp - dq)));
+        }
+    }
+}
+
+// Whether some corners all lie outside a side of a surface, or no more
+// than OVERLAP_EPSILON inside it
+bool outsideSide(const SurfaceList& list, const Surface& surface, const glm::vec2* corners, size_t count) {
+    for (size_t side = 0; side < surface.count; side++) {
+        const glm::vec2& point = list.corners[surface.first + side];
+        const glm::vec2& normal = list.normals[surface.first + side];
+        size_t k = 0;
+        while (k < count && glm::dot(corners[k] - point, normal) <= OVERLAP_EPSILON) k++;
+        if (k == count) return true;
+    }
+    return false;
+}
+
+// Two convex surfaces are apart exactly when one lies outside a side of
+// the other. Surfaces that only touch, like the strip ends and patch of a
+// mitered join, do not overlap.
+bool surfacesOverlap(const SurfaceList& list, const Surface& s, const Surface& t) {
+    if (std::min(s.high.x, t.high.x) - std::max(s.low.x, t.low.x) <= OVERLAP_EPSILON ||
+        std::min(s.high.y, t.high.y) - std::max(s.low.y, t.low.y) <= OVERLAP_EPSILON) {
+        return false;
+    }
+    return !outsideSide(list, s, list.corners.data() + t.first, t.count) &&
+           !outsideSide(list, t, list.corners.data() + s.first, s.count);
+}
+
+// What of some convex pieces lies outside a surface: outside one of its
+// sides and inside the sides before it, so the new pieces stay convex and
+// do not overlap
+void subtractSurface(const PolygonList& pieces, const SurfaceList& list, const Surface& surface,
+                     PolygonList& out, std::vector<glm::vec2>& inside, std::vector<glm::vec2>& outside) {
+    out.clear();
+    for (size_t i = 0; i < pieces.size(); i++) {
+        const glm::vec2* piece = pieces.points.data() + pieces.first(i);
+        size_t count = pieces.ends[i] - pieces.first(i);
+        
+        // Most pieces lie wholly on one side of most lines, and away
+        // from most surfaces altogether
+        glm::vec2 low = piece[0], high = piece[0];
+        for (size_t k = 1; k < count; k++) {
+            low = glm::min(low, piece[k]);
+            high = glm::max(high, piece[k]);
+        }
+        if (low.x >= surface.high.x || high.x <= surface.low.x ||
+            low.y >= surface.high.y || high.y <= surface.low.y) {
+            out.add(piece, count);
+            continue;
+        }
+        
+        inside.assign(piece, piece + count);
+        for (size_t side = 0; side < surface.count && !inside.empty(); side++) {
+            const glm::vec2& point = list.corners[surface.first + side];
+            const glm::vec2& normal = list.normals[surface.first + side];
+            float nearest = glm::dot(inside[0] - point, normal), furthest = nearest;
+            for (size_t k = 1; k < inside.size(); k++) {
+                float d = glm::dot(inside[k] - point, normal);
+                nearest = std::min(nearest, d);
+                furthest = std::max(furthest, d);
+            }
+            if (nearest >= 0.0f) continue;
+            if (furthest <= 0.0f) {
+                out.add(inside.data(), inside.size());
+                inside.clear();
+                break;
+            }
             
-            // Second triangle
-            vertices.insert(vertices.end(), {
-                v2.x, roadHeight, v2.y,  1.0f, 0.0f,
-                v4.x, roadHeight, v4.y,  1.0f, texRepeat,
-                v3.x, roadHeight, v3.y,  0.0f, texRepeat
-            });
+            clipToHalfPlane(inside.data(), inside.size(), point, -normal, outside);
+            if (outside.size() >= 3 && !isSliver(outside.data(), outside.size())) {
+                out.add(outside.data(), outside.size());
+            }
+            clipToHalfPlane(inside.data(), inside.size(), point, normal, outside);
+            inside.swap(outside);
+            if (inside.size() < 3) break;
+        }
+    }
+}
+
+bool insideMargins(const WorldExtent& world, float x, float y) {
+    return x >= world.margin && x <= world.width - world.margin &&
+           y >= world.margin && y <= world.height - world.margin;
+}
+
+// Point of an edge's underlying road line, in view space
+glm::vec2 viewPoint(const Road& road, float t, const WorldExtent& world) {
+    return glm::vec2(world.toViewX(road.start.x + (road.end.x - road.start.x) * t),
+                     world.toViewY(road.start.y + (road.end.y - road.start.y) * t));
+}
+
+} // namespace
+
+std::vector<float> roadNetworkTo3DMesh(const std::vector<Road>& roads, const RoadGraph& graph,
+                                       const WorldExtent& world, bool is3D) {
+    std::vector<float> vertices;
+    const std::vector<RoadNode>& nodes = graph.getNodes();
+    const std::vector<RoadEdge>& edges = graph.getEdges();
+    
+    // A strip per edge, and a patch of about three triangles per arm
+    vertices.reserve(edges.size() * (6 + 2 * 9) * 5);
+    
+    // Roads may run along one another (random layouts can repeat a road).
+    // Of edges joining the same two nodes only the widest is meshed.
+    std::vector<bool> hidden(edges.size(), false);
+    std::map<std::pair<int, int>, int> widest;  // Node pair -> edge
+    for (size_t e = 0; e < edges.size(); e++) {
+        std::pair<int, int> ends(std::min(edges[e].from, edges[e].to), std::max(edges[e].from, edges[e].to));
+        auto found = widest.emplace(ends, static_cast<int>(e));
+        if (found.second) continue;
+        
+        int& kept = found.first->second;
+        if (roads[edges[e].road].width > roads[edges[kept].road].width) {
+            hidden[kept] = true;
+            kept = static_cast<int>(e);
         } else {
-            // 2D MODE: Z is depth (for orthographic view)
-            // First triangle
-            vertices.insert(vertices.end(), {
-                v1.x, v1.y, roadHeight,  0.0f, 0.0f,
-                v2.x, v2.y, roadHeight,  1.0f, 0.0f,
-                v3.x, v3.y, roadHeight,  0.0f, texRepeat
-            });
+            hidden[e] = true;
+        }
+    }
+    
+    // How far each edge's strip is cut back at its tStart and tEnd ends
+    std::vector<float> trimStart(edges.size(), 0.0f);
+    std::vector<float> trimEnd(edges.size(), 0.0f);
+    
+    std::vector<JunctionArm> arms;
+    std::vector<glm::vec2> outline;
+    std::vector<glm::vec2> fan;
+    std::vector<glm::vec2> sides;
+    std::vector<float> cornerA;     // Trim arm i needs on its left, towards arm i + 1
+    std::vector<float> cornerB;     // Trim arm i + 1 needs on its right, towards arm i
+    std::vector<Join> joins;        // How arms i and i + 1 meet
+    SurfaceList surfaces;           // Patches, then strips
+    
+    for (size_t n = 0; n < nodes.size(); n++) {
+        const RoadNode& node = nodes[n];
+        
+        // Dead ends keep their square end; junctions on or past the margins
+        // are left to clipping
+        if (node.edges.size() < 2 || !insideMargins(world, node.x, node.y)) continue;
+        
+        glm::vec2 center(world.toViewX(node.x), world.toViewY(node.y));
+        
+        arms.clear();
+        for (int e : node.edges) {
+            if (hidden[e]) continue;
+            const RoadEdge& edge = edges[e];
+            const Road& road = roads[edge.road];
+            glm::vec2 from = viewPoint(road, edge.tStart, world);
+            glm::vec2 to = viewPoint(road, edge.tEnd, world);
+            float length = glm::length(to - from);
+            if (length == 0.0f) continue;
             
-            // Second triangle
-            vertices.insert(vertices.end(), {
-                v2.x, v2.y, roadHeight,  1.0f, 0.0f,
-                v4.x, v4.y, roadHeight,  1.0f, texRepeat,
-                v3.x, v3.y, roadHeight,  0.0f, texRepeat
-            });
+            JunctionArm arm;
+            arm.edge = e;
+            arm.atStart = (edge.from == static_cast<int>(n));
+            arm.dir = (arm.atStart ? to - from : from - to) / length;
+            arm.halfWidth = world.toViewSizeX(road.width) / 2.0f;
+            arm.angle = std::atan2(arm.dir.y, arm.dir.x);
+            arm.maxTrim = length / 2.0f;
+            arm.trim = 0.0f;
+            arms.push_back(arm);
+        }
+        if (arms.size() < 2) continue;
+        
+        // A road running straight on through a shared end needs no patch
+        if (arms.size() == 2 && std::fabs(cross(arms[0].dir, arms[1].dir)) < PARALLEL_EPSILON &&
+            glm::dot(arms[0].dir, arms[1].dir) < 0.0f) {
+            continue;
+        }
+        
+        std::sort(arms.begin(), arms.end(), [](const JunctionArm& a, const JunctionArm& b) {
+            return a.angle < b.angle;
+        });
+        
+        // Between each pair of neighbouring arms, the left edge of one
+        // meets the right edge of the next. Cutting both strips back to
+        // that corner leaves the space between them to the patch.
+        size_t count = arms.size();
+        cornerA.assign(count, 0.0f);
+        cornerB.assign(count, 0.0f);
+        joins.assign(count, Join::OVERLAP);
+        for (size_t i = 0; i < count; i++) {
+            const JunctionArm& a = arms[i];
+            const JunctionArm& b = arms[(i + 1) % count];
+            
+            // Arms more than half a turn apart (the outside of a bend) are
+            // joined by a bevel straight across the junction
+            float gap = b.angle - a.angle;
+            if (i + 1 == count) gap += 2.0f * static_cast<float>(M_PI);
+            if (gap >= static_cast<float>(M_PI) - PARALLEL_EPSILON) {
+                joins[i] = Join::BEVEL;
+                continue;
+            }
+            float det = -cross(a.dir, b.dir);
+            if (std::fabs(det) < PARALLEL_EPSILON) continue;
+            
+            // Solve center + leftA * ha + s * dirA = center + rightB * hb + t * dirB
+            glm::vec2 leftA(-a.dir.y, a.dir.x);
+            glm::vec2 rightB(b.dir.y, -b.dir.x);
+            glm::vec2 w = rightB * b.halfWidth - leftA * a.halfWidth;
+            float s = cross(b.dir, w) / det;
+            float t = cross(a.dir, w) / det;
+            
+            // At sharp angles the corner lies far down both roads. Past the
+            // middle of either edge the strips are cut there and overlap
+            // instead, leaving the rest of the edge to its other end. The
+            // corner also leaves part of a road uncovered when the junction
+            // end of one strip reaches past the far side of the other, as
+            // a wide road does meeting a narrow one at a sharp angle.
+            float reach = std::fabs(glm::dot(a.dir, b.dir));
+            bool meets = reach * a.halfWidth <= b.halfWidth + POINT_EPSILON &&
+                         reach * b.halfWidth <= a.halfWidth + POINT_EPSILON;
+            if (!meets || s > a.maxTrim || t > b.maxTrim) continue;
+            
+            joins[i] = Join::MITER;
+            cornerA[i] = std::max(s, 0.0f);
+            cornerB[i] = std::max(t, 0.0f);
+        }
+        
+        // A strip next to an overlap runs on to the junction point, so its
+        // whole road is covered; the cut end only shapes the patch
+        for (size_t i = 0; i < count; i++) {
+            JunctionArm& arm = arms[i];
+            size_t previous = (i + count - 1) % count;
+            arm.trim = std::max(cornerA[i], cornerB[previous]);
+            bool overlaps = joins[i] == Join::OVERLAP || joins[previous] == Join::OVERLAP;
+            (arm.atStart ? trimStart : trimEnd)[arm.edge] = overlaps ? 0.0f : arm.trim;
+        }
+        
+        // Patch outline, counter-clockwise: each strip's cut end, then the
+        // corner shared with the next arm, or for a bevel the strip corners
+        // at the junction point, which no strip covers any more. An overlap
+        // goes back through the junction point: the strips on either side
+        // cover that side, and anything wider would spill between them.
+        outline.clear();
+        float patchHalfWidth = 0.0f;
+        for (size_t i = 0; i < count; i++) {
+            const JunctionArm& arm = arms[i];
+            glm::vec2 left(-arm.dir.y, arm.dir.x);
+            glm::vec2 end = center + arm.dir * arm.trim;
+            outline.push_back(end - left * arm.halfWidth);
+            outline.push_back(end + left * arm.halfWidth);
+            if (joins[i] == Join::MITER) {
+                outline.push_back(center + left * arm.halfWidth + arm.dir * cornerA[i]);
+            } else if (joins[i] == Join::BEVEL) {
+                const JunctionArm& next = arms[(i + 1) % count];
+                outline.push_back(center + left * arm.halfWidth);
+                outline.push_back(center + glm::vec2(next.dir.y, -next.dir.x) * next.halfWidth);
+            } else {
+                outline.push_back(center);
+            }
+            patchHalfWidth = std::max(patchHalfWidth, arm.halfWidth);
+        }
+        
+        // The patch is textured with one road width of the texture,
+        // centred on the junction
+        Surface patch;
+        patch.origin = center;
+        patch.uv = glm::vec2(0.5f);
+        patch.uAxis = glm::vec2(1.0f / (2.0f * patchHalfWidth), 0.0f);
+        patch.vAxis = glm::vec2(0.0f, 1.0f / (2.0f * patchHalfWidth));
+        
+        // A convex patch stays whole. Others are split into as few convex
+        // fans around the junction point as it takes; where short edges
+        // fold the outline over itself the fans overlap, and are cut like
+        // any other surfaces below.
+        if (isConvex(outline, sides)) {
+            surfaces.add(outline, patch);
+            continue;
+        }
+        size_t start = 0;
+        while (start < outline.size()) {
+            fan.assign({ center, outline[start] });
+            size_t end = start + 1;
+            while (end <= outline.size()) {
+                fan.push_back(outline[end % outline.size()]);
+                if (fan.size() > 3 && !isConvex(fan, sides)) {
+                    fan.pop_back();
+                    break;
+                }
+                end++;
+            }
+            surfaces.add(fan, patch);
+            start = end - 1;
+        }
+    }
+    
+    // Strips: every edge between its cut ends, clipped to the margins.
+    // Wider roads come first, so they stay whole where strips overlap.
+    std::vector<int> order(edges.size());
+    for (size_t e = 0; e < edges.size(); e++) order[e] = static_cast<int>(e);
+    std::stable_sort(order.begin(), order.end(), [&](int e1, int e2) {
+        return roads[edges[e1].road].width > roads[edges[e2].road].width;
+    });
+    for (int e : order) {
+        if (hidden[e]) continue;
+        const RoadEdge& edge = edges[e];
+        const Road& road = roads[edge.road];
+        float px0 = road.start.x + (road.end.x - road.start.x) * edge.tStart;
+        float py0 = road.start.y + (road.end.y - road.start.y) * edge.tStart;
+        float px1 = road.start.x + (road.end.x - road.start.x) * edge.tEnd;
+        float py1 = road.start.y + (road.end.y - road.start.y) * edge.tEnd;
+        float tMin = 0.0f, tMax = 1.0f;
+        if (!clipSegmentToBox(px0, py0, px1, py1,
+                              world.margin, world.margin, world.width - world.margin, world.height - world.margin,
+                              tMin, tMax)) {
+            continue;
+        }
+        
+        glm::vec2 a(world.toViewX(px0 + (px1 - px0) * tMin), world.toViewY(py0 + (py1 - py0) * tMin));
+        glm::vec2 b(world.toViewX(px0 + (px1 - px0) * tMax), world.toViewY(py0 + (py1 - py0) * tMax));
+        float length = glm::length(b - a);
+        
+        // Ends cut by clipping are at the margins, not at a junction
+        float cutA = (tMin == 0.0f) ? trimStart[e] : 0.0f;
+        float cutB = (tMax == 1.0f) ? trimEnd[e] : 0.0f;
+        if (cutA + cutB >= length) continue;  // Entirely inside the patches
+        
+        glm::vec2 dir = (b - a) / length;
+        a += dir * cutA;
+        b -= dir * cutB;
+        
+        // U runs across the road as in addRoadQuad(). V counts from the
+        // start of the road's kept interval, so the texture runs on
+        // unbroken across junctions.
+        glm::vec2 roadStart(world.toViewX(road.x0()), world.toViewY(road.y0()));
+        float halfWidth = world.toViewSizeX(road.width) / 2.0f;
+        glm::vec2 perp(-dir.y, dir.x);
+        Surface strip;
+        strip.origin = a;
+        strip.uv = glm::vec2(0.5f, glm::length(a - roadStart) * TEXTURE_REPEAT);
+        strip.uAxis = -perp / (2.0f * halfWidth);
+        strip.vAxis = dir * TEXTURE_REPEAT;
+        surfaces.add({ a + perp * halfWidth, a - perp * halfWidth, b - perp * halfWidth, b + perp * halfWidth }, strip);
+    }
+    
+    // Surfaces still overlap where arms meet too sharply for a corner,
+    // where junctions lie closer together than a road is wide, and where
+    // nearly collinear or repeated roads run side by side between
+    // different junctions. Each point is left to the first surface that
+    // covers it; later ones are cut into the convex pieces outside it.
+    // The grid only holds the surfaces before the one being cut, about
+    // one per cell once all are in.
+    const std::vector<Surface>& all = surfaces.surfaces;
+    SpatialGrid grid;
+    float cellSize = std::sqrt(world.width * world.height / std::max<size_t>(all.size(), 1));
+    grid.reset(static_cast<int>(std::ceil(world.width)), static_cast<int>(std::ceil(world.height)), std::max(cellSize, 1.0f));
+    auto worldBounds = [&](const Surface& surface, glm::vec2& low, glm::vec2& high) {
+        // View Y runs opposite to world Y
+        low = glm::vec2((surface.low.x + 1.0f) * world.width / 2.0f, (1.0f - surface.high.y) * world.height / 2.0f);
+        high = glm::vec2((surface.high.x + 1.0f) * world.width / 2.0f, (1.0f - surface.low.y) * world.height / 2.0f);
+    };
+    glm::vec2 low, high;
+    std::vector<int> visited(all.size(), -1);
+    std::vector<int> earlier;
+    PolygonList pieces, cutPieces;
+    std::vector<glm::vec2> inside, outside;
+    for (size_t i = 0; i < all.size(); i++) {
+        const Surface& surface = all[i];
+        earlier.clear();
+        worldBounds(surface, low, high);
+        grid.forEachInRange(low.x, low.y, high.x, high.y, [&](const GridEntry& entry) {
+            if (visited[entry.index] != static_cast<int>(i)) {
+                visited[entry.index] = static_cast<int>(i);
+                if (surfacesOverlap(surfaces, all[entry.index], surface)) earlier.push_back(entry.index);
+            }
+            return true;
+        });
+        grid.insert(GridEntry(GridEntryKind::ROAD, static_cast<int>(i)), low.x, low.y, high.x, high.y);
+        
+        pieces.clear();
+        pieces.add(surfaces.corners.data() + surface.first, surface.count);
+        for (int j : earlier) {
+            subtractSurface(pieces, surfaces, all[j], cutPieces, inside, outside);
+            std::swap(pieces, cutPieces);
+        }
+        
+        // Fan each piece, with the texture coordinates of the whole surface.
+        // Cuts and merged outlines leave corners on one line, whose
+        // triangles would have no area.
+        for (size_t k = 0; k < pieces.size(); k++) {
+            const glm::vec2* piece = pieces.points.data() + pieces.first(k);
+            size_t count = pieces.ends[k] - pieces.first(k);
+            for (size_t v = 1; v + 1 < count; v++) {
+                glm::vec2 triangle[3] = { piece[0], piece[v], piece[v + 1] };
+                if (isSliver(triangle, 3)) continue;
+                for (const glm::vec2& p : triangle) {
+                    glm::vec2 uv = surface.uvAt(p);
+                    addRoadVertex(vertices, p, uv.x, uv.y, is3D);
+                }
+            }
         }
     }
     
     return vertices;
 }
+
+namespace {
+
+// Point of a mesh vertex in the vertex format of addRoadVertex(), in view space
+glm::vec2 meshPoint(const std::vector<float>& vertices, size_t vertex, bool is3D) {
+    return glm::vec2(vertices[vertex * 5], vertices[vertex * 5 + (is3D ? 2 : 1)]);
+}
+
+// Count every sample of the view square grid inside a triangle. A sample on
+// an edge counts for the triangle on the left of the edge when it runs down
+// (or right), so two triangles sharing the edge count it once between them.
+void coverSamples(glm::vec2 a, glm::vec2 b, glm::vec2 c, int samples, std::vector<unsigned char>& counts) {
+    if (cross(b - a, c - a) < 0.0f) std::swap(b, c);
+    const glm::vec2 corners[3] = { a, b, c };
+    
+    float step = 2.0f / samples;
+    auto first = [&](float low) { return std::max(0, static_cast<int>(std::ceil((low + 1.0f) / step - 0.5f))); };
+    auto last = [&](float high) { return std::min(samples - 1, static_cast<int>(std::floor((high + 1.0f) / step - 0.5f))); };
+    int x0 = first(std::min({ a.x, b.x, c.x }));
+    int x1 = last(std::max({ a.x, b.x, c.x }));
+    int y0 = first(std::min({ a.y, b.y, c.y }));
+    int y1 = last(std::max({ a.y, b.y, c.y }));
+    
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            glm::vec2 p(-1.0f + (x + 0.5f) * step, -1.0f + (y + 0.5f) * step);
+            bool inside = true;
+            for (int i = 0; i < 3 && inside; i++) {
+                glm::vec2 side = corners[(i + 1) % 3] - corners[i];
+                float w = cross(side, p - corners[i]);
+                inside = w > 0.0f || (w == 0.0f && (side.y < 0.0f || (side.y == 0.0f && side.x > 0.0f)));
+            }
+            unsigned char& count = counts[static_cast<size_t>(y) * samples + x];
+            if (inside && count < 255) count++;
+        }
+    }
+}
+
+} // namespace
+
+RoadCoverage measureRoadCoverage(const std::vector<Road>& roads, const std::vector<float>& vertices,
+                                 const WorldExtent& world, bool is3D, int samples) {
+    RoadCoverage coverage = { 0, 0, 0, 0 };
+    if (samples <= 0) return coverage;
+    
+    size_t total = static_cast<size_t>(samples) * samples;
+    std::vector<unsigned char> plain(total, 0);
+    std::vector<unsigned char> joined(total, 0);
+    
+    for (const Road& road : roads) {
+        std::vector<float> quad = roadTo3DMesh(road, world, is3D);
+        for (size_t v = 0; v + 3 <= quad.size() / 5; v += 3) {
+            coverSamples(meshPoint(quad, v, is3D), meshPoint(quad, v + 1, is3D), meshPoint(quad, v + 2, is3D),
+                         samples, plain);
+        }
+    }
+    
+    for (size_t v = 0; v + 3 <= vertices.size() / 5; v += 3) {
+        glm::vec2 triangle[3] = { meshPoint(vertices, v, is3D), meshPoint(vertices, v + 1, is3D),
+                                  meshPoint(vertices, v + 2, is3D) };
+        if (isSliver(triangle, 3)) {
+            coverage.zeroArea++;
+            continue;
+        }
+        coverSamples(triangle[0], triangle[1], triangle[2], samples, joined);
+    }
+    
+    for (size_t i = 0; i < total; i++) {
+        if (plain[i]) {
+            coverage.covered++;
+            if (!joined[i]) coverage.holes++;
+        }
+        if (joined[i] > 1) coverage.overdrawn++;
+    }
+    return coverage;
+}
+
+bool checkRoadJoins() {
+    struct JoinCase {
+        const char* name;
+        std::vector<Road> roads;
+    };
+    const JoinCase cases[] = {
+        { "sharp V", { Road(Point(390, 400), Point(400, 400), 14), Road(Point(400, 400), Point(100, 430), 14) } },
+        { "3 degree crossing", { Road(Point(100, 400), Point(700, 400), 14), Road(Point(300, 405), Point(500, 395), 14) } },
+        { "wide into narrow", { Road(Point(400, 400), Point(312, 472), 16), Road(Point(312, 472), Point(458, 476), 4) } },
+    };
+    const WorldExtent world(800.0f, 800.0f);
+    const int samples = 1024;
+    
+    bool passed = true;
+    for (const JoinCase& join : cases) {
+        RoadGraph graph;
+        graph.build(join.roads);
+        std::vector<float> vertices = roadNetworkTo3DMesh(join.roads, graph, world, true);
+        RoadCoverage coverage = measureRoadCoverage(join.roads, vertices, world, true, samples);
+        
+        bool clean = coverage.holes == 0 && coverage.overdrawn == 0 && coverage.zeroArea == 0;
+        passed = passed && clean;
+        std::cout << (clean ? "✅ " : "❌ ") << "Road join " << join.name << ": " << coverage.holes
+                  << " holes, " << coverage.overdrawn << " overdrawn of " << coverage.covered
+                  << " samples, " << coverage.zeroArea << " zero-area triangles\n";
+    }
+    return passed;
+}
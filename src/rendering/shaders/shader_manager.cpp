@@ -10,26 +10,34 @@
 #include <iostream>
 #include <glm/gtc/type_ptr.hpp>
 
-// Vertex Shader Source (supports both 2D and 3D with textures)
+// Vertex Shader Source (supports both 2D and 3D with textures, and
+// instanced buildings)
 const char* ShaderManager::getVertexShaderSource() {
     return R"(
 #version 330 core
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec2 aTexCoord;
+layout (location = 2) in vec3 aOffset;      // Per instance
+layout (location = 3) in vec3 aScale;       // Per instance
+layout (location = 4) in int aMaterial;     // Per instance
 
 out vec2 TexCoord;
+flat out int Material;
 
 uniform mat4 view;
 uniform mat4 projection;
 uniform bool is2D;
+uniform bool instanced;
 
 void main() {
+    vec3 position = instanced ? aOffset + aPos * aScale : aPos;
     if (is2D) {
-        gl_Position = vec4(aPos.x, aPos.y, 0.0, 1.0);
+        gl_Position = vec4(position.x, position.y, 0.0, 1.0);
     } else {
-        gl_Position = projection * view * vec4(aPos, 1.0);
+        gl_Position = projection * view * vec4(position, 1.0);
     }
     TexCoord = aTexCoord;
+    Material = instanced ? aMaterial : 0;
 }
 )";
 }
@@ -41,14 +49,29 @@ const char* ShaderManager::getFragmentShaderSource() {
 out vec4 FragColor;
 
 in vec2 TexCoord;
+flat in int Material;
 
 uniform vec3 color;
 uniform bool useTexture;
 uniform sampler2D buildingTex;
 
+// Instanced buildings pick their texture or colour by material
+uniform bool instanced;
+uniform sampler2D materialTex[3];
+uniform vec3 materialColor[3];
+
 void main() {
-    if (useTexture) {
+    if (useTexture && instanced) {
+        // Samplers can only be indexed by constants, so all three are
+        // sampled outside the branch (keeping mipmap derivatives defined)
+        vec4 texels[3] = vec4[3](texture(materialTex[0], TexCoord),
+                                 texture(materialTex[1], TexCoord),
+                                 texture(materialTex[2], TexCoord));
+        FragColor = texels[Material];
+    } else if (useTexture) {
         FragColor = texture(buildingTex, TexCoord);
+    } else if (instanced) {
+        FragColor = vec4(materialColor[Material], 1.0);
     } else {
         FragColor = vec4(color, 1.0);
     }
@@ -59,7 +82,8 @@ void main() {
 ShaderManager::ShaderManager() 
     : shaderProgram(0), isCompiled(false),
       colorLocation(-1), viewLocation(-1), projectionLocation(-1),
-      useTextureLocation(-1), is2DLocation(-1) {
+      useTextureLocation(-1), is2DLocation(-1), instancedLocation(-1),
+      materialTexLocation(-1), materialColorLocation(-1) {
 }
 
 ShaderManager::~ShaderManager() {
@@ -130,6 +154,14 @@ bool ShaderManager::compileShaders() {
     // Cache uniform locations
     cacheUniformLocations();
     
+    // Material textures are read from units 0-2, where
+    // CityRenderer::renderBuildings() binds one texture per building type
+    if (materialTexLocation != -1) {
+        const GLint units[3] = { 0, 1, 2 };
+        glUseProgram(shaderProgram);
+        glUniform1iv(materialTexLocation, 3, units);
+    }
+    
     isCompiled = true;
     std::cout << "✅ Shaders compiled and linked successfully\n";
     return true;
@@ -141,6 +173,9 @@ void ShaderManager::cacheUniformLocations() {
     projectionLocation = glGetUniformLocation(shaderProgram, "projection");
     useTextureLocation = glGetUniformLocation(shaderProgram, "useTexture");
     is2DLocation = glGetUniformLocation(shaderProgram, "is2D");
+    instancedLocation = glGetUniformLocation(shaderProgram, "instanced");
+    materialTexLocation = glGetUniformLocation(shaderProgram, "materialTex");
+    materialColorLocation = glGetUniformLocation(shaderProgram, "materialColor");
 }
 
 void ShaderManager::use() const {
@@ -178,3 +213,15 @@ void ShaderManager::setIs2D(bool is2D) const {
         glUniform1i(is2DLocation, is2D ? 1 : 0);
     }
 }
+
+void ShaderManager::setInstanced(bool instanced) const {
+    if (instancedLocation != -1) {
+        glUniform1i(instancedLocation, instanced ? 1 : 0);
+    }
+}
+
+void ShaderManager::setMaterialColors(const float* colors) const {
+    if (materialColorLocation != -1) {
+        glUniform3fv(materialColorLocation, 3, colors);
+    }
+}
@@ -1,4 +1,6 @@
 #include "utils/algorithms.h"
+#include <algorithm>
+#include <cstdlib>
 
 // Bresenham's Line Algorithm Implementation
 // This algorithm calculates which pixels to draw for a straight line
@@ -12,6 +14,19 @@ std::vector<Point> bresenhamLine(int x0, int y0, int x1, int y1) {
     int sx = (x0 < x1) ? 1 : -1;  // Step direction in x
     int sy = (y0 < y1) ? 1 : -1;  // Step direction in y
     
+    // A line has exactly one pixel per step along its major axis
+    points.reserve(std::max(dx, dy) + 1);
+    
+    // Axis-aligned fast paths: no error term needed
+    if (dy == 0) {
+        for (int x = x0; x != x1 + sx; x += sx) points.push_back(Point(x, y0));
+        return points;
+    }
+    if (dx == 0) {
+        for (int y = y0; y != y1 + sy; y += sy) points.push_back(Point(x0, y));
+        return points;
+    }
+    
     int err = dx - dy;  // Error term
     
     int x = x0;
@@ -88,3 +103,74 @@ std::vector<Point> midpointCircle(int centerX, int centerY, int radius) {
     
     return points;
 }
+
+// Upper half-plane (screen down) first, then by cross product within a half
+static bool angularLess(const Point& a, const Point& b) {
+    int halfA = (a.y > 0 || (a.y == 0 && a.x > 0)) ? 0 : 1;
+    int halfB = (b.y > 0 || (b.y == 0 && b.x > 0)) ? 0 : 1;
+    if (halfA != halfB) return halfA < halfB;
+    return static_cast<long long>(a.x) * b.y - static_cast<long long>(a.y) * b.x > 0;
+}
+
+std::vector<Point> midpointCircleOrdered(int centerX, int centerY, int radius) {
+    if (radius < 0) return std::vector<Point>();
+    
+    // Sort the offsets from the center, then translate them
+    std::vector<Point> points = midpointCircle(0, 0, radius);
+    std::sort(points.begin(), points.end(), angularLess);
+    points.erase(std::unique(points.begin(), points.end(),
+                             [](const Point& a, const Point& b) { return a.x == b.x && a.y == b.y; }),
+                 points.end());
+    for (auto& p : points) {
+        p.x += centerX;
+        p.y += centerY;
+    }
+    return points;
+}
+
+std::vector<PixelSpan> midpointDiscSpans(int centerX, int centerY, int radius) {
+    std::vector<PixelSpan> spans;
+    if (radius < 0) return spans;
+    
+    // Widest perimeter pixel in each row bounds the fill of that row
+    std::vector<int> halfWidth(2 * radius + 1, 0);
+    for (const auto& p : midpointCircle(0, 0, radius)) {
+        int& w = halfWidth[p.y + radius];
+        w = std::max(w, std::abs(p.x));
+    }
+    
+    spans.reserve(halfWidth.size());
+    for (int row = -radius; row <= radius; row++) {
+        int w = halfWidth[row + radius];
+        spans.push_back(PixelSpan(centerX - w, centerY + row, 2 * w + 1, false, 1));
+    }
+    return spans;
+}
+
+void CirclePatternCache::discSpans(int centerX, int centerY, int radius,
+                                   std::vector<PixelSpan>& spans) {
+    spans.clear();
+    if (radius < 0) return;
+    
+    auto it = discs.find(radius);
+    if (it == discs.end()) {
+        it = discs.emplace(radius, midpointDiscSpans(0, 0, radius)).first;
+    }
+    
+    spans.reserve(it->second.size());
+    for (const auto& s : it->second) {
+        spans.push_back(PixelSpan(centerX + s.x, centerY + s.y, s.length, false, 1));
+    }
+}
+
+// Circle perimeter is only needed for 2D point rendering, so it is
+// rasterized lazily the first time it is requested
+const std::vector<Point>& Circle::perimeter() const {
+    if (!rasterized) {
+        if (!empty()) {
+            perimeterPoints = midpointCircleOrdered(centerX, centerY, radius);
+        }
+        rasterized = true;
+    }
+    return perimeterPoints;
+}
@@ -0,0 +1,377 @@
+/**
+ * @file delaunay.cpp
+ * @brief Implementation of Sweep-Hull Delaunay Triangulation
+ *
+ * @author City Designer Team
+ * @date November 2025
+ */
+
+#include "utils/delaunay.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace {
+
+const double DUPLICATE_EPSILON = std::numeric_limits<double>::epsilon();
+
+// Twice the signed area of triangle (p, q, r); positive when r is to the
+// left of p->q in a Y-up frame
+double cross(double px, double py, double qx, double qy, double rx, double ry) {
+    return (qx - px) * (ry - py) - (qy - py) * (rx - px);
+}
+
+// Whether p lies inside the circumcircle of (a, b, c)
+bool inCircle(double ax, double ay, double bx, double by, double cx, double cy,
+              double px, double py) {
+    double dx = ax - px, dy = ay - py;
+    double ex = bx - px, ey = by - py;
+    double fx = cx - px, fy = cy - py;
+
+    double ap = dx * dx + dy * dy;
+    double bp = ex * ex + ey * ey;
+    double cp = fx * fx + fy * fy;
+
+    return dx * (ey * cp - bp * fy) - dy * (ex * cp - bp * fx) + ap * (ex * fy - ey * fx) < 0.0;
+}
+
+// Circumcenter of (a, b, c) relative to a; infinite for collinear points
+void circumOffset(double ax, double ay, double bx, double by, double cx, double cy,
+                  double& ox, double& oy) {
+    double dx = bx - ax, dy = by - ay;
+    double ex = cx - ax, ey = cy - ay;
+    double bl = dx * dx + dy * dy;
+    double cl = ex * ex + ey * ey;
+    double d = 0.5 / (dx * ey - dy * ex);
+    ox = (ey * bl - dy * cl) * d;
+    oy = (dx * cl - ex * bl) * d;
+}
+
+double circumradiusSquared(double ax, double ay, double bx, double by, double cx, double cy) {
+    double ox, oy;
+    circumOffset(ax, ay, bx, by, cx, cy, ox, oy);
+    double r = ox * ox + oy * oy;
+    return std::isfinite(r) ? r : std::numeric_limits<double>::infinity();
+}
+
+// Monotonic stand-in for atan2 in [0, 1), used to hash hull vertices by angle
+double pseudoAngle(double dx, double dy) {
+    double p = dx / (std::fabs(dx) + std::fabs(dy));
+    return (dy > 0.0 ? 3.0 - p : 1.0 + p) / 4.0;
+}
+
+// Triangles are stored as half-edges: half-edge e belongs to triangle e / 3
+// and starts at point triangles[e]; halfedges[e] is its twin in the
+// neighbouring triangle, or -1 on the convex hull
+class Triangulator {
+private:
+    const std::vector<Point>& points;
+    std::vector<int> triangles;
+    std::vector<int> halfedges;
+
+    // Convex hull as a circular doubly linked list over point indices
+    std::vector<int> hullPrev;
+    std::vector<int> hullNext;
+    std::vector<int> hullTri;       // Hull half-edge leaving each hull point
+    std::vector<int> hullHash;
+    int hullStart;
+
+    double centerX, centerY;        // Circumcenter of the seed triangle
+    std::vector<int> edgeStack;
+
+public:
+    explicit Triangulator(const std::vector<Point>& pts) : points(pts), hullStart(-1),
+                                                           centerX(0.0), centerY(0.0) {}
+
+    std::vector<int> run() {
+        size_t n = points.size();
+        if (n < 3) return {};
+
+        // Seed: the point nearest the bounding box center, its nearest
+        // neighbour, and the third point giving the smallest circumcircle
+        double minX = std::numeric_limits<double>::infinity(), minY = minX;
+        double maxX = -minX, maxY = -minX;
+        for (const auto& p : points) {
+            minX = std::min(minX, static_cast<double>(p.x));
+            minY = std::min(minY, static_cast<double>(p.y));
+            maxX = std::max(maxX, static_cast<double>(p.x));
+            maxY = std::max(maxY, static_cast<double>(p.y));
+        }
+        double midX = (minX + maxX) / 2.0;
+        double midY = (minY + maxY) / 2.0;
+
+        int i0 = nearestTo(midX, midY, -1);
+        int i1 = nearestTo(x(i0), y(i0), i0);
+        if (i1 < 0) return {};
+
+        int i2 = -1;
+        double minRadius = std::numeric_limits<double>::infinity();
+        for (size_t i = 0; i < n; i++) {
+            int k = static_cast<int>(i);
+            if (k == i0 || k == i1) continue;
+            double r = circumradiusSquared(x(i0), y(i0), x(i1), y(i1), x(k), y(k));
+            if (r < minRadius) {
+                i2 = k;
+                minRadius = r;
+            }
+        }
+        if (i2 < 0) return {};  // All points collinear
+
+        if (cross(x(i0), y(i0), x(i1), y(i1), x(i2), y(i2)) > 0.0) {
+            std::swap(i1, i2);
+        }
+
+        double ox, oy;
+        circumOffset(x(i0), y(i0), x(i1), y(i1), x(i2), y(i2), ox, oy);
+        centerX = x(i0) + ox;
+        centerY = y(i0) + oy;
+
+        // Sweep order: distance from the seed circumcenter
+        std::vector<double> distance(n);
+        for (size_t i = 0; i < n; i++) {
+            double dx = x(i) - centerX, dy = y(i) - centerY;
+            distance[i] = dx * dx + dy * dy;
+        }
+        std::vector<int> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](int a, int b) {
+            return distance[a] < distance[b] || (distance[a] == distance[b] && a < b);
+        });
+
+        size_t maxTriangles = 2 * n - 5;
+        triangles.reserve(maxTriangles * 3);
+        halfedges.reserve(maxTriangles * 3);
+
+        hullPrev.assign(n, 0);
+        hullNext.assign(n, 0);
+        hullTri.assign(n, 0);
+        hullHash.assign(static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(n)))), -1);
+
+        hullStart = i0;
+        hullNext[i0] = hullPrev[i2] = i1;
+        hullNext[i1] = hullPrev[i0] = i2;
+        hullNext[i2] = hullPrev[i1] = i0;
+        hullTri[i0] = 0;
+        hullTri[i1] = 1;
+        hullTri[i2] = 2;
+        hullHash[hashKey(x(i0), y(i0))] = i0;
+        hullHash[hashKey(x(i1), y(i1))] = i1;
+        hullHash[hashKey(x(i2), y(i2))] = i2;
+
+        addTriangle(i0, i1, i2, -1, -1, -1);
+
+        double prevX = 0.0, prevY = 0.0;
+        for (size_t k = 0; k < n; k++) {
+            int i = order[k];
+            double px = x(i), py = y(i);
+
+            // Skip duplicates of the previous point and the seed itself
+            if (k > 0 && std::fabs(px - prevX) <= DUPLICATE_EPSILON &&
+                std::fabs(py - prevY) <= DUPLICATE_EPSILON) {
+                continue;
+            }
+            prevX = px;
+            prevY = py;
+            if (i == i0 || i == i1 || i == i2) continue;
+
+            addPoint(i, px, py);
+        }
+
+        return std::move(triangles);
+    }
+
+private:
+    double x(size_t i) const { return points[i].x; }
+    double y(size_t i) const { return points[i].y; }
+
+    int nearestTo(double px, double py, int skip) const {
+        int best = -1;
+        double bestDistance = std::numeric_limits<double>::infinity();
+        for (size_t i = 0; i < points.size(); i++) {
+            if (static_cast<int>(i) == skip) continue;
+            double dx = x(i) - px, dy = y(i) - py;
+            double d = dx * dx + dy * dy;
+            if (d < bestDistance && (skip < 0 || d > 0.0)) {
+                best = static_cast<int>(i);
+                bestDistance = d;
+            }
+        }
+        return best;
+    }
+
+    size_t hashKey(double px, double py) const {
+        double angle = pseudoAngle(px - centerX, py - centerY);
+        return static_cast<size_t>(std::floor(angle * hullHash.size())) % hullHash.size();
+    }
+
+    void link(int a, int b) {
+        halfedges[a] = b;
+        if (b != -1) halfedges[b] = a;
+    }
+
+    int addTriangle(int i0, int i1, int i2, int a, int b, int c) {
+        int t = static_cast<int>(triangles.size());
+        triangles.push_back(i0);
+        triangles.push_back(i1);
+        triangles.push_back(i2);
+        halfedges.resize(triangles.size(), -1);
+        link(t, a);
+        link(t + 1, b);
+        link(t + 2, c);
+        return t;
+    }
+
+    void addPoint(int i, double px, double py) {
+        // Find a hull edge visible from the point, starting near its angle
+        int start = 0;
+        size_t key = hashKey(px, py);
+        for (size_t j = 0; j < hullHash.size(); j++) {
+            start = hullHash[(key + j) % hullHash.size()];
+            if (start != -1 && start != hullNext[start]) break;
+        }
+
+        start = hullPrev[start];
+        int e = start;
+        int q = hullNext[e];
+        while (cross(px, py, x(e), y(e), x(q), y(q)) <= 0.0) {
+            e = q;
+            if (e == start) return;  // Not outside the hull: a near-duplicate
+            q = hullNext[e];
+        }
+
+        // Join the point to the first visible edge
+        int t = addTriangle(e, i, hullNext[e], -1, -1, hullTri[e]);
+        hullTri[i] = legalize(t + 2);
+        hullTri[e] = t;
+
+        // Walk forward along the hull while edges stay visible
+        int next = hullNext[e];
+        q = hullNext[next];
+        while (cross(px, py, x(next), y(next), x(q), y(q)) > 0.0) {
+            t = addTriangle(next, i, q, hullTri[i], -1, hullTri[next]);
+            hullTri[i] = legalize(t + 2);
+            hullNext[next] = next;  // Removed from the hull
+            next = q;
+            q = hullNext[next];
+        }
+
+        // Walk backward from the first edge as well
+        if (e == start) {
+            q = hullPrev[e];
+            while (cross(px, py, x(q), y(q), x(e), y(e)) > 0.0) {
+                t = addTriangle(q, i, e, -1, hullTri[e], hullTri[q]);
+                legalize(t + 2);
+                hullTri[q] = t;
+                hullNext[e] = e;  // Removed from the hull
+                e = q;
+                q = hullPrev[e];
+            }
+        }
+
+        hullStart = hullPrev[i] = e;
+        hullNext[e] = hullPrev[next] = i;
+        hullNext[i] = next;
+
+        hullHash[hashKey(px, py)] = i;
+        hullHash[hashKey(x(e), y(e))] = e;
+    }
+
+    // Flip edges until the triangles around half-edge a are Delaunay.
+    // Returns the half-edge that now plays the role of a's predecessor.
+    int legalize(int a) {
+        edgeStack.clear();
+        int ar = 0;
+
+        while (true) {
+            int b = halfedges[a];
+            int a0 = a - a % 3;
+            ar = a0 + (a + 2) % 3;
+
+            if (b == -1) {  // Convex hull edge: nothing to flip
+                if (edgeStack.empty()) break;
+                a = edgeStack.back();
+                edgeStack.pop_back();
+                continue;
+            }
+
+            int b0 = b - b % 3;
+            int al = a0 + (a + 1) % 3;
+            int bl = b0 + (b + 2) % 3;
+
+            int p0 = triangles[ar];
+            int pr = triangles[a];
+            int pl = triangles[al];
+            int p1 = triangles[bl];
+
+            if (inCircle(x(p0), y(p0), x(pr), y(pr), x(pl), y(pl), x(p1), y(p1))) {
+                triangles[a] = p1;
+                triangles[b] = p0;
+
+                int hbl = halfedges[bl];
+
+                // The flipped edge was on the hull's far side; fix its reference
+                if (hbl == -1) {
+                    int e = hullStart;
+                    do {
+                        if (hullTri[e] == bl) {
+                            hullTri[e] = a;
+                            break;
+                        }
+                        e = hullPrev[e];
+                    } while (e != hullStart);
+                }
+
+                link(a, hbl);
+                link(b, halfedges[ar]);
+                link(ar, bl);
+
+                edgeStack.push_back(b0 + (b + 1) % 3);
+            } else {
+                if (edgeStack.empty()) break;
+                a = edgeStack.back();
+                edgeStack.pop_back();
+            }
+        }
+
+        return ar;
+    }
+};
+
+} // namespace
+
+std::vector<int> delaunayTriangulate(const std::vector<Point>& points) {
+    return Triangulator(points).run();
+}
+
+std::vector<std::pair<int, int>> delaunayEdges(const std::vector<Point>& points) {
+    std::vector<std::pair<int, int>> edges;
+    std::vector<int> triangles = delaunayTriangulate(points);
+
+    if (triangles.empty()) {
+        // Collinear (or fewer than three) points: chain them along the line
+        std::vector<int> order(points.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](int a, int b) {
+            return points[a].x < points[b].x || (points[a].x == points[b].x && points[a].y < points[b].y);
+        });
+        for (size_t i = 1; i < order.size(); i++) {
+            const Point& a = points[order[i - 1]];
+            const Point& b = points[order[i]];
+            if (a.x == b.x && a.y == b.y) continue;
+            edges.emplace_back(std::min(order[i - 1], order[i]), std::max(order[i - 1], order[i]));
+        }
+        return edges;
+    }
+
+    // Every interior edge appears in two triangles; keep it once
+    edges.reserve(triangles.size() / 2 + 1);
+    for (size_t e = 0; e < triangles.size(); e++) {
+        int a = triangles[e];
+        int b = triangles[e - e % 3 + (e + 1) % 3];
+        edges.emplace_back(std::min(a, b), std::max(a, b));
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    return edges;
+}
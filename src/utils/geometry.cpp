@@ -0,0 +1,133 @@
+#include "utils/geometry.h"
+#include <algorithm>
+#include <cmath>
+
+// Liang-Barsky Line Clipping
+// Each box edge bounds the parameter t from one side; the segment is
+// inside the box for the intersection of all four half-ranges
+bool clipSegmentToBox(float x0, float y0, float x1, float y1,
+                      float minX, float minY, float maxX, float maxY,
+                      float& tMin, float& tMax) {
+    float dx = x1 - x0;
+    float dy = y1 - y0;
+
+    // p = direction component against each edge, q = distance to that edge
+    float p[4] = { -dx, dx, -dy, dy };
+    float q[4] = { x0 - minX, maxX - x0, y0 - minY, maxY - y0 };
+
+    for (int i = 0; i < 4; i++) {
+        if (p[i] == 0.0f) {
+            // Parallel to this edge: reject if outside it
+            if (q[i] < 0.0f) {
+                return false;
+            }
+            continue;
+        }
+
+        float t = q[i] / p[i];
+        if (p[i] < 0.0f) {
+            // Entering the box across this edge
+            if (t > tMin) tMin = t;
+        } else {
+            // Leaving the box across this edge
+            if (t < tMax) tMax = t;
+        }
+
+        if (tMin > tMax) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool segmentIntersectsBox(float x0, float y0, float x1, float y1,
+                          float minX, float minY, float maxX, float maxY) {
+    float tMin = 0.0f;
+    float tMax = 1.0f;
+    return clipSegmentToBox(x0, y0, x1, y1, minX, minY, maxX, maxY, tMin, tMax);
+}
+
+// Squared distance from a point to an axis-aligned box (0 if inside)
+static float pointBoxDistanceSquared(float px, float py,
+                                     float minX, float minY, float maxX, float maxY) {
+    float dx = std::max(minX - px, std::max(0.0f, px - maxX));
+    float dy = std::max(minY - py, std::max(0.0f, py - maxY));
+    return dx * dx + dy * dy;
+}
+
+// Squared distance from a point to a segment
+static float pointSegmentDistanceSquared(float px, float py,
+                                         float x0, float y0, float x1, float y1) {
+    float dx = x1 - x0;
+    float dy = y1 - y0;
+    float lengthSquared = dx * dx + dy * dy;
+
+    float t = 0.0f;
+    if (lengthSquared > 0.0f) {
+        t = ((px - x0) * dx + (py - y0) * dy) / lengthSquared;
+        t = std::max(0.0f, std::min(1.0f, t));
+    }
+
+    float ex = x0 + t * dx - px;
+    float ey = y0 + t * dy - py;
+    return ex * ex + ey * ey;
+}
+
+float segmentBoxDistanceSquared(float x0, float y0, float x1, float y1,
+                                float minX, float minY, float maxX, float maxY) {
+    if (segmentIntersectsBox(x0, y0, x1, y1, minX, minY, maxX, maxY)) {
+        return 0.0f;
+    }
+
+    // Disjoint convex shapes: the minimum is attained at a segment endpoint
+    // or at a box corner
+    float best = std::min(pointBoxDistanceSquared(x0, y0, minX, minY, maxX, maxY),
+                          pointBoxDistanceSquared(x1, y1, minX, minY, maxX, maxY));
+    best = std::min(best, pointSegmentDistanceSquared(minX, minY, x0, y0, x1, y1));
+    best = std::min(best, pointSegmentDistanceSquared(maxX, minY, x0, y0, x1, y1));
+    best = std::min(best, pointSegmentDistanceSquared(minX, maxY, x0, y0, x1, y1));
+    best = std::min(best, pointSegmentDistanceSquared(maxX, maxY, x0, y0, x1, y1));
+    return best;
+}
+
+bool thickSegmentOverlapsBox(float x0, float y0, float x1, float y1, float halfWidth,
+                             float minX, float minY, float maxX, float maxY) {
+    // Cheap reject: the capsule lies inside the segment's bounds grown by halfWidth
+    if (std::max(x0, x1) + halfWidth < minX || std::min(x0, x1) - halfWidth > maxX ||
+        std::max(y0, y1) + halfWidth < minY || std::min(y0, y1) - halfWidth > maxY) {
+        return false;
+    }
+
+    return segmentBoxDistanceSquared(x0, y0, x1, y1, minX, minY, maxX, maxY) < halfWidth * halfWidth;
+}
+
+// Line-Circle Intersection
+// Substituting the parametric line into the circle equation gives the
+// quadratic a*t^2 + 2*b*t + c = 0; its roots bound the inside interval
+bool lineCircleInterval(float x0, float y0, float x1, float y1,
+                        float cx, float cy, float radius,
+                        float& tEnter, float& tExit) {
+    float dx = x1 - x0;
+    float dy = y1 - y0;
+    float fx = x0 - cx;
+    float fy = y0 - cy;
+
+    float a = dx * dx + dy * dy;
+    if (a == 0.0f) {
+        return false;  // Degenerate line has no interior
+    }
+
+    float b = fx * dx + fy * dy;
+    float c = fx * fx + fy * fy - radius * radius;
+
+    float discriminant = b * b - a * c;
+    if (discriminant <= 0.0f) {
+        return false;  // Misses or only touches the circle
+    }
+
+    float root = std::sqrt(discriminant);
+    tEnter = (-b - root) / a;
+    tExit = (-b + root) / a;
+    return true;
+}
@@ -1,9 +1,13 @@
 #include "utils/input_handler.h"
-#include "generation/city_generator.h"
+#include "generation/generation_worker.h"
 #include <iostream>
 #include <cstring>
+#include <random>
 
-InputHandler::InputHandler(CityConfig& cfg) : config(cfg), cityGen(nullptr), genRequested(false) {
+// Where the J key saves the generation profile
+static const char* PROFILE_PATH = "generation_profile.json";
+
+InputHandler::InputHandler(CityConfig& cfg) : config(cfg), generationWorker(nullptr) {
     // Initialize key states
     std::memset(keysPressed, 0, sizeof(keysPressed));
 }
@@ -33,20 +37,36 @@ void InputHandler::processInput(GLFWwindow* window) {
         config.printConfig();
     }
     
+    // === WORLD CONTROLS ===
+    // X - Cycle through scale tiers
+    if (isKeyJustPressed(window, GLFW_KEY_X)) {
+        int current = static_cast<int>(config.scaleTier);
+        current = (current + 1) % 3;  // 3 scale tiers
+        config.scaleTier = static_cast<ScaleTier>(current);
+        config.applyScaleTier();
+        std::cout << "Scale: " << config.getScaleTierString() << " ("
+                  << static_cast<int>(config.world.width) << "x" << static_cast<int>(config.world.height)
+                  << " units, up to " << config.maxBuildings() << " buildings)\n";
+    }
+    
     // === BUILDING CONTROLS ===
+    // Step sizes grow with the scale tier so every range takes ~20 presses
+    int buildingStep = std::max(5, config.maxBuildings() / 20);
+    int layoutStep = std::max(1, config.maxLayoutSize() / 20);
+    
     // 1/2 - Increase/Decrease number of buildings
     if (isKeyJustPressed(window, GLFW_KEY_1)) {
-        config.numBuildings = std::max(1, config.numBuildings - 5);
+        config.numBuildings = std::max(1, config.numBuildings - buildingStep);
         std::cout << "Buildings: " << config.numBuildings << "\n";
     }
     if (isKeyJustPressed(window, GLFW_KEY_2)) {
-        config.numBuildings = std::min(100, config.numBuildings + 5);
+        config.numBuildings = std::min(config.maxBuildings(), config.numBuildings + buildingStep);
         std::cout << "Buildings: " << config.numBuildings << "\n";
     }
     
     // 3/4 - Increase/Decrease layout size
     if (isKeyJustPressed(window, GLFW_KEY_3)) {
-        config.layoutSize = std::max(5, config.layoutSize - 1);
+        config.layoutSize = std::max(5, config.layoutSize - layoutStep);
         config.updateStandardBuildingSize();  // Auto-adjust building size
         std::cout << "Layout Size: " << config.layoutSize << "x" << config.layoutSize << "\n";
         if (config.useStandardSize) {
@@ -55,7 +75,7 @@ void InputHandler::processInput(GLFWwindow* window) {
         }
     }
     if (isKeyJustPressed(window, GLFW_KEY_4)) {
-        config.layoutSize = std::min(20, config.layoutSize + 1);
+        config.layoutSize = std::min(config.maxLayoutSize(), config.layoutSize + layoutStep);
         config.updateStandardBuildingSize();  // Auto-adjust building size
         std::cout << "Layout Size: " << config.layoutSize << "x" << config.layoutSize << "\n";
         if (config.useStandardSize) {
@@ -77,7 +97,7 @@ void InputHandler::processInput(GLFWwindow* window) {
     // R - Cycle through road patterns
     if (isKeyJustPressed(window, GLFW_KEY_R)) {
         int current = static_cast<int>(config.roadPattern);
-        current = (current + 1) % 3;  // 3 patterns
+        current = (current + 1) % 4;  // 4 patterns
         config.roadPattern = static_cast<RoadPattern>(current);
         std::cout << "Road Pattern: " << config.getRoadPatternString() << "\n";
     }
@@ -137,6 +157,22 @@ void InputHandler::processInput(GLFWwindow* window) {
         std::cout << "Fountain Radius: " << config.fountainRadius << "\n";
     }
     
+    // === PLACEMENT CONTROLS ===
+    // M - Cycle through placement modes
+    if (isKeyJustPressed(window, GLFW_KEY_M)) {
+        int current = static_cast<int>(config.placementMode);
+        current = (current + 1) % 4;  // 4 placement modes
+        config.placementMode = static_cast<PlacementMode>(current);
+        std::cout << "Placement Mode: " << config.getPlacementModeString() << "\n";
+    }
+    
+    // C - Toggle geometric/raster collision backend
+    if (isKeyJustPressed(window, GLFW_KEY_C)) {
+        config.collisionBackend = (config.collisionBackend == CollisionBackend::GEOMETRIC)
+            ? CollisionBackend::RASTER : CollisionBackend::GEOMETRIC;
+        std::cout << "Collision Backend: " << config.getCollisionBackendString() << "\n";
+    }
+    
     // === VIEW MODE ===
     // V - Toggle 2D/3D view
     if (isKeyJustPressed(window, GLFW_KEY_V)) {
@@ -144,11 +180,34 @@ void InputHandler::processInput(GLFWwindow* window) {
         std::cout << "View Mode: " << (config.view3D ? "3D" : "2D") << "\n";
     }
     
-    // G - Generate new city with current settings
+    // N - Roll a new seed (press G to generate with it)
+    if (isKeyJustPressed(window, GLFW_KEY_N)) {
+        std::random_device rd;
+        config.seed = rd();
+        std::cout << "Seed: " << config.seed << "\n";
+    }
+    
+    // G - Generate new city with current settings. Generation runs in the
+    // background; pressing G again before it finishes starts over with the
+    // newer settings.
     if (isKeyJustPressed(window, GLFW_KEY_G)) {
-        genRequested = true;
-        if (cityGen) {
-            cityGen->generateCity(config);
+        if (generationWorker) {
+            generationWorker->request(config);
+        }
+    }
+    
+    // J - Print the profile of the last generation run and save it as JSON
+    if (isKeyJustPressed(window, GLFW_KEY_J)) {
+        GenerationProfile profile;
+        if (!generationWorker || !generationWorker->getProfile(profile)) {
+            std::cout << "No generation profile yet (press G to generate a city)\n";
+        } else {
+            std::cout << profile.toJson();
+            if (profile.saveJson(PROFILE_PATH)) {
+                std::cout << "Profile saved to " << PROFILE_PATH << "\n";
+            } else {
+                std::cerr << "Warning: could not write " << PROFILE_PATH << "\n";
+            }
         }
     }
 }
@@ -158,13 +217,16 @@ void InputHandler::displayControls() {
     std::cout << "╔═══════════════════════════════════════════════════════════╗\n";
     std::cout << "║              CITY DESIGNER - KEYBOARD CONTROLS            ║\n";
     std::cout << "╠═══════════════════════════════════════════════════════════╣\n";
+    std::cout << "║  WORLD CONTROLS:                                          ║\n";
+    std::cout << "║    X    : Cycle scale tier (District/City/Metropolis)     ║\n";
+    std::cout << "║                                                           ║\n";
     std::cout << "║  BUILDING CONTROLS:                                       ║\n";
     std::cout << "║    1/2  : Decrease/Increase number of buildings           ║\n";
     std::cout << "║    3/4  : Decrease/Increase layout size                   ║\n";
     std::cout << "║    B    : Toggle standard/random building size            ║\n";
     std::cout << "║                                                           ║\n";
     std::cout << "║  ROAD CONTROLS:                                           ║\n";
-    std::cout << "║    R    : Cycle road pattern (Grid/Radial/Random)        ║\n";
+    std::cout << "║    R    : Cycle road pattern (Grid/Radial/Random/Organic) ║\n";
     std::cout << "║    5/6  : Decrease/Increase road width                    ║\n";
     std::cout << "║                                                           ║\n";
     std::cout << "║  SKYLINE CONTROLS:                                        ║\n";
@@ -180,9 +242,15 @@ void InputHandler::displayControls() {
     std::cout << "║    9/0  : Decrease/Increase number of parks               ║\n";
     std::cout << "║    F    : Toggle fountain size (small/large)              ║\n";
     std::cout << "║                                                           ║\n";
+    std::cout << "║  PLACEMENT CONTROLS:                                      ║\n";
+    std::cout << "║    M    : Cycle placement (Random/Poisson/Tiles/Lots)     ║\n";
+    std::cout << "║    C    : Toggle collision backend (Geometric/Raster)     ║\n";
+    std::cout << "║                                                           ║\n";
     std::cout << "║  VIEW & GENERATION:                                       ║\n";
     std::cout << "║    V    : Toggle 2D/3D view mode                          ║\n";
+    std::cout << "║    N    : Roll a new random seed                          ║\n";
     std::cout << "║    G    : Generate new city with current settings         ║\n";
+    std::cout << "║    J    : Print and save last generation profile (JSON)   ║\n";
     std::cout << "║    P    : Print current configuration                     ║\n";
     std::cout << "║    H    : Display this help menu                          ║\n";
     std::cout << "║    ESC  : Exit application                                ║\n";
@@ -132,15 +132,10 @@ echo ""
 
 echo -e "${BLUE}Test 9: Performance Metrics${NC}"
 echo "========================================"
-echo "Grid Pattern (10x10):"
-echo "  - Roads: 22 segments"
-echo "  - Generation time: < 10ms"
-echo "  - Points per road: ~400-600"
-echo ""
-echo "Park Generation:"
-echo "  - Parks: 3 random + 1 fountain"
-echo "  - Points per park (r=40): ~252"
-echo "  - Generation time: < 5ms"
+echo "Generation is profiled on every run. In the app, generate a city (G)"
+echo "and press J: per-stage times, bytes allocated, placement attempts and"
+echo "rejections by cause, and rasterized pixels are printed and saved to"
+echo "generation_profile.json."
 echo ""
 
 echo -e "${YELLOW}═══════════════════════════════════════════════════════════${NC}"